@@ -67,6 +67,43 @@ string iso_639_from_tag(string dict_tag) {
 	return dict_tag.substring(0, dict_tag.index_of_char('_'));
 }
 
+/* A provider dictionary shared between sessions, and the number of
+   sessions using it. */
+[Compact]
+class EnchantSharedDict {
+	public unowned EnchantProviderDict dict;
+	public int users;
+}
+
+/* A provider module found by a lazy broker, which is only loaded when one
+   of its dictionaries may be needed. */
+[Compact]
+class EnchantProviderModule {
+	public string name; /* the provider's identity, guessed from the file name until loaded */
+	public string filename;
+	public bool loaded = false;
+	public unowned EnchantProvider? provider = null;
+}
+
+/* The providers named by an ordering, and the providers they resolve to
+   in the broker's list, which is recomputed when the list changes. */
+[Compact]
+class EnchantProviderOrdering {
+	public string[] names;
+	public GenericArray<unowned EnchantProvider>? providers = null;
+	public uint provider_list_changes = 0;
+
+	public EnchantProviderOrdering(string ordering) {
+		string[] names = {};
+		foreach (unowned string token in ordering.split(",", 0)) {
+			string name = token.strip();
+			if (name.length > 0)
+				names += name;
+		}
+		this.names = names;
+	}
+}
+
 [CCode (has_target = false)]
 delegate EnchantProvider EnchantProviderInitFunc();
 [CCode (has_target = false)]
@@ -75,25 +112,80 @@ delegate void EnchantPreConfigureFunc(EnchantProvider provider, string module_di
 [Compact (opaque = true)]
 public class EnchantBroker {
 	SList<EnchantProvider> provider_list;   /* list of all of the spelling backend providers */
-	HashTable<string, string> provider_ordering; /* map of language tag -> provider order */
+	HashTable<string, EnchantProviderOrdering> provider_ordering; /* map of language tag -> provider order */
 	GenericSet<EnchantDict> sessions;
 
 	string _error;
 
+	/* Later fields are not seen by the provider tests' copy of this
+	   structure. */
+	bool lazy = false;
+	SList<EnchantProviderModule> provider_modules; /* provider modules, if lazy */
+	uint provider_list_changes = 0; /* incremented when a provider is added */
+	EnchantProviderOrdering default_ordering; /* used when no ordering applies */
+	bool share_dicts = false;
+	HashTable<string, EnchantSharedDict> shared_dicts; /* map of provider:tag -> shared dict */
+	EnchantDiscoveryIndex discovery_index;
+	Mutex task_mutex;
+	Cond task_cond;
+	int running_tasks = 0; /* composite dictionary tasks on the worker pool */
+
 	[CCode (cname = "enchant_broker_init")]
 	public EnchantBroker() {
+		this.init(false);
+	}
+
+	[CCode (cname = "enchant_broker_init_lazy")]
+	public EnchantBroker.lazy() {
+		this.init(true);
+	}
+
+	void init(bool lazy) {
 		if (!Module.supported())
 			return;
 
+		this.lazy = lazy;
+		this.default_ordering = new EnchantProviderOrdering("");
 		this.load_providers();
 		this.load_provider_ordering();
 		this.sessions = new GenericSet<EnchantDict>(direct_hash, direct_equal);
+		this.shared_dicts = new HashTable<string, EnchantSharedDict>(str_hash, str_equal);
+		/* Let a whole process opt in to sharing without changing each
+		   caller. */
+		unowned string? share = Environment.get_variable("ENCHANT_SHARE_DICTS");
+		this.share_dicts = share != null && share != "" && share != "0";
+		this.discovery_index = new EnchantDiscoveryIndex(
+			Path.build_filename(Environment.get_user_cache_dir(), "enchant", "dictionaries.index"));
 	}
 
 	~EnchantBroker() {
 		// Do not crash if called from C without an instance.
 		// Use return_if_fail to skip Vala's deallocation code.
 		return_if_fail(this != null);
+		this.wait_for_tasks();
+	}
+
+	internal void task_started() {
+		this.task_mutex.lock();
+		this.running_tasks++;
+		this.task_mutex.unlock();
+	}
+
+	internal void task_finished() {
+		this.task_mutex.lock();
+		this.running_tasks--;
+		this.task_cond.broadcast();
+		this.task_mutex.unlock();
+	}
+
+	/* Composite dictionary tasks may still be running after the call that
+	   started them has returned; they must finish before the providers are
+	   freed. */
+	void wait_for_tasks() {
+		this.task_mutex.lock();
+		while (this.running_tasks > 0)
+			this.task_cond.wait(this.task_mutex);
+		this.task_mutex.unlock();
 	}
 
 	public void clear_error() {
@@ -116,7 +208,7 @@ public class EnchantBroker {
 
 		if (tag_dupl != null && tag_dupl.length > 0 &&
 			ordering_dupl != null && ordering_dupl.length > 0)
-			this.provider_ordering.insert(tag_dupl, ordering_dupl);
+			this.provider_ordering.insert(tag_dupl, new EnchantProviderOrdering(ordering_dupl));
 	}
 
 	void load_providers() {
@@ -133,38 +225,95 @@ public class EnchantBroker {
 			return;
 		}
 
+		/* Load the providers in a deterministic order. */
+		var filenames = new SList<string>();
 		string dir_entry;
-		while ((dir_entry = dir.read_name()) != null) {
-			Module? module = null;
-			EnchantProvider? provider = null;
-
-			if (dir_entry[0] != '.') { /* Skip hidden files */
-				string filename = Path.build_filename(dir_name, dir_entry);
-				try {
-					module = new Module(filename, 0);
-					void *init_func;
-					if (module.symbol("init_enchant_provider", out init_func)
-						&& init_func != null) {
-						provider = ((EnchantProviderInitFunc)init_func)();
-						if (!EnchantProvider.is_valid(provider)) {
-							warning("Error loading plugin: %s's init_enchant_provider returned invalid provider", dir_entry);
-							if (provider != null) {
-								if (provider.dispose != null)
-									provider.dispose(provider);
-								provider = null;
-							}
-						}
-					}
-				} catch (ModuleError e) {
-					warning("Error loading plugin: %s", Module.error());
-				}
+		while ((dir_entry = dir.read_name()) != null)
+			if (dir_entry[0] != '.') /* Skip hidden files */
+				filenames.insert_sorted(Path.build_filename(dir_name, dir_entry), strcmp);
+
+		if (this.lazy) {
+			foreach (string filename in filenames) {
+				/* Provider modules are named "enchant_" followed by the
+				   provider's identity. */
+				var module = new EnchantProviderModule();
+				string name = Path.get_basename(filename);
+				name = name.substring(0, name.index_of_char('.'));
+				module.name = name.has_prefix("enchant_") ? name.substring("enchant_".length) : name;
+				module.filename = filename;
+				this.provider_modules.append((owned)module);
 			}
-			if (provider != null) {
-				provider.module = (owned)module;
-				provider.owner = this;
-				this.provider_list.append((owned)provider);
+		} else {
+			foreach (string filename in filenames)
+				this.init_provider(open_module(filename), filename);
+		}
+	}
+
+	static Module? open_module(string filename) {
+		try {
+			return new Module(filename, 0);
+		} catch (ModuleError e) {
+			warning("Error loading plugin: %s", e.message);
+			return null;
+		}
+	}
+
+	unowned EnchantProvider? init_provider(owned Module? module, string filename) {
+		if (module == null)
+			return null;
+
+		EnchantProvider? provider = null;
+		void *init_func;
+		if (module.symbol("init_enchant_provider", out init_func)
+			&& init_func != null) {
+			provider = ((EnchantProviderInitFunc)init_func)();
+			if (!EnchantProvider.is_valid(provider)) {
+				warning("Error loading plugin: %s's init_enchant_provider returned invalid provider", Path.get_basename(filename));
+				if (provider != null) {
+					if (provider.dispose != null)
+						provider.dispose(provider);
+					provider = null;
+				}
 			}
 		}
+
+		if (provider == null)
+			return null;
+		provider.module = (owned)module;
+		provider.owner = this;
+		unowned EnchantProvider provider_ref = provider;
+		this.provider_list.append((owned)provider);
+		this.provider_list_changes++;
+		return provider_ref;
+	}
+
+	/* Record that a lazy broker's module has been loaded, and learn the
+	   provider's real name. */
+	void module_loaded(EnchantProviderModule module, owned Module? handle) {
+		module.loaded = true;
+		module.provider = this.init_provider((owned)handle, module.filename);
+		if (module.provider != null)
+			module.name = module.provider.identify(module.provider);
+	}
+
+	/* Load a lazy broker's module, if it has not been loaded already. */
+	unowned EnchantProvider? load_module(EnchantProviderModule module) {
+		if (!module.loaded)
+			this.module_loaded(module, open_module(module.filename));
+		return module.provider;
+	}
+
+	/* Load those of a lazy broker's remaining modules whose guessed names
+	   are not in skip_names, or all of them if it is null. */
+	void load_modules(GenericSet<unowned string>? skip_names) {
+		foreach (unowned EnchantProviderModule module in this.provider_modules)
+			if (!module.loaded && (skip_names == null || !skip_names.contains(module.name)))
+				this.module_loaded(module, open_module(module.filename));
+	}
+
+	/* Load all of a lazy broker's remaining modules. */
+	void load_all_modules() {
+		this.load_modules(null);
 	}
 
 	void load_ordering_from_file(string file) {
@@ -197,7 +346,7 @@ public class EnchantBroker {
 	}
 
 	public void load_provider_ordering() {
-		this.provider_ordering = new HashTable<string, string>(str_hash, str_equal);
+		this.provider_ordering = new HashTable<string, EnchantProviderOrdering>(str_hash, str_equal);
 
 		SList<string> conf_dirs = enchant_get_conf_dirs();
 		foreach (string dir in conf_dirs) {
@@ -206,33 +355,89 @@ public class EnchantBroker {
 		}
 	}
 
-	public SList<unowned EnchantProvider>? get_ordered_providers(string? tag) {
+	unowned EnchantProviderOrdering get_ordering(string tag) {
+		unowned EnchantProviderOrdering? ordering = this.provider_ordering.lookup(tag);
+		if (ordering == null)
+			ordering = this.provider_ordering.lookup("*");
+		if (ordering == null)
+			ordering = this.default_ordering;
+		return ordering;
+	}
+
+	public unowned GenericArray<unowned EnchantProvider>? get_ordered_providers(string? tag) {
 		if (tag == null)
 			return null;
 
-		string ordering = this.provider_ordering.lookup(tag);
-		if (ordering == null)
-			ordering = this.provider_ordering.lookup("*");
+		unowned EnchantProviderOrdering ordering = this.get_ordering(tag);
+		if (ordering.providers != null &&
+			ordering.provider_list_changes == this.provider_list_changes)
+			return ordering.providers;
+
+		var providers = new GenericArray<unowned EnchantProvider>();
+		var listed = new GenericSet<unowned EnchantProvider>(direct_hash, direct_equal);
+		foreach (unowned string name in ordering.names)
+			foreach (unowned EnchantProvider provider in this.provider_list)
+				if (!listed.contains(provider) && name == provider.identify(provider)) {
+					providers.add(provider);
+					listed.add(provider);
+				}
 
-		var list = new SList<unowned EnchantProvider>();
+		/* append providers not in the list, or from an unordered list */
+		foreach (unowned EnchantProvider provider in this.provider_list)
+			if (!listed.contains(provider))
+				providers.add(provider);
 
-		if (ordering != null) {
-			var tokens = ordering.split(",", 0);
-			foreach (unowned string token in tokens) {
-				string tok = token.strip();
+		ordering.providers = providers;
+		ordering.provider_list_changes = this.provider_list_changes;
+		return ordering.providers;
+	}
+
+	/* The position of provider in providers, or -1 if it is not there. */
+	static int provider_priority(GenericArray<unowned EnchantProvider> providers, EnchantProvider provider) {
+		for (int i = 0; i < providers.length; i++)
+			if (providers[i] == provider)
+				return i;
+		return -1;
+	}
 
-				foreach (unowned EnchantProvider provider in this.provider_list)
-					if (provider != null && tok == provider.identify(provider))
-						list.append(provider);
+	/* Like get_ordered_providers, but for a lazy broker's modules.  The
+	   name of a module that has not been loaded is only a guess, so if the
+	   ordering names a provider that no module seems to be, the modules
+	   it does not name are loaded to find out what they really are. */
+	GenericArray<unowned EnchantProviderModule> get_ordered_modules(string tag) {
+		unowned EnchantProviderOrdering ordering = this.get_ordering(tag);
+		var known = new GenericSet<unowned string>(str_hash, str_equal);
+		foreach (unowned EnchantProviderModule module in this.provider_modules)
+			known.add(module.name);
+		foreach (unowned string name in ordering.names)
+			if (!known.contains(name)) {
+				var named = new GenericSet<unowned string>(str_hash, str_equal);
+				foreach (unowned string n in ordering.names)
+					named.add(n);
+				this.load_modules(named);
+				break;
 			}
-		}
 
-		/* append providers not in the list, or from an unordered list */
-		foreach (unowned EnchantProvider provider in this.provider_list)
-			if (list.find(provider) == null)
-				list.append(provider);
+		var modules = new GenericArray<unowned EnchantProviderModule>();
+		var listed = new GenericSet<unowned EnchantProviderModule>(direct_hash, direct_equal);
+		foreach (unowned string name in ordering.names)
+			foreach (unowned EnchantProviderModule module in this.provider_modules)
+				if (!listed.contains(module) && name == module.name) {
+					modules.add(module);
+					listed.add(module);
+				}
 
-		return list;
+		/* append modules not in the list, by file name, as an eager broker
+		   would load them */
+		var rest = new GenericArray<unowned EnchantProviderModule>();
+		foreach (unowned EnchantProviderModule module in this.provider_modules)
+			if (!listed.contains(module))
+				rest.add(module);
+		rest.sort((a, b) => strcmp(a.filename, b.filename));
+		foreach (unowned EnchantProviderModule module in rest)
+			modules.add(module);
+
+		return modules;
 	}
 
 	public unowned EnchantDict? request_pwl_dict(string? pwl)
@@ -255,16 +460,75 @@ public class EnchantBroker {
 		return this.new_dict(session);
 	}
 
+	public void set_share_dicts(bool share) {
+		this.clear_error();
+		this.share_dicts = share;
+	}
+
+	/* Get a provider dictionary, reusing an existing one if dictionaries
+	   are shared.  If the result is shared, shared_key is set to its key in
+	   shared_dicts. */
+	EnchantProviderDict? request_provider_dict(EnchantProvider provider, string tag, out string? shared_key) {
+		shared_key = null;
+		if (!this.share_dicts)
+			return provider.request_dict(provider, tag);
+
+		string key = "%s:%s".printf(provider.identify(provider), tag);
+		unowned EnchantSharedDict? shared = this.shared_dicts.lookup(key);
+		if (shared != null) {
+			shared.users++;
+			shared_key = key;
+			return shared.dict;
+		}
+
+		EnchantProviderDict? dict = provider.request_dict(provider, tag);
+		if (dict != null) {
+			/* The sessions sharing the dictionary may be used on different
+			   threads, whether or not they are in concurrent mode. */
+			if (provider.serialize_dict_calls)
+				dict.set_serialize_calls(true);
+			var entry = new EnchantSharedDict();
+			entry.dict = dict;
+			entry.users = 1;
+			this.shared_dicts.insert(key, (owned)entry);
+			shared_key = key;
+		}
+		return dict;
+	}
+
 	unowned EnchantDict? _request_dict(string tag, string? pwl) {
+		if (this.lazy) {
+			/* Only load modules until one provides the dictionary. */
+			foreach (unowned EnchantProviderModule module in this.get_ordered_modules(tag)) {
+				unowned EnchantProvider? provider = this.load_module(module);
+				if (provider != null) {
+					unowned EnchantDict? session = this.request_session(provider, tag, pwl);
+					if (session != null)
+						return session;
+				}
+			}
+			return null;
+		}
+
 		foreach (unowned EnchantProvider provider in this.get_ordered_providers(tag)) {
-			EnchantProviderDict? dict = provider.request_dict(provider, tag);
-			if (dict != null)
-				return this.new_dict(EnchantDict.with_implicit_pwl(dict, tag, pwl));
+			unowned EnchantDict? session = this.request_session(provider, tag, pwl);
+			if (session != null)
+				return session;
 		}
 
 		return null;
 	}
 
+	unowned EnchantDict? request_session(EnchantProvider provider, string tag, string? pwl) {
+		string? shared_key;
+		EnchantProviderDict? dict = this.request_provider_dict(provider, tag, out shared_key);
+		if (dict == null)
+			return null;
+		EnchantDict session = EnchantDict.with_implicit_pwl(dict, tag, pwl);
+		session.shared_key = shared_key;
+		return this.new_dict(session);
+	}
+
 	public unowned EnchantDict? request_dict_with_pwl(string? composite_tag, string? pwl)
 	{
 		if (composite_tag == null || composite_tag.length == 0)
@@ -310,6 +574,7 @@ public class EnchantBroker {
 		if (fn == null)
 			return;
 
+		this.load_all_modules();
 		foreach (unowned EnchantProvider provider in this.provider_list) {
 			string name = provider.identify(provider);
 			string desc = provider.describe(provider);
@@ -328,26 +593,27 @@ public class EnchantBroker {
 
 		this.clear_error();
 		debug("listing dictionaries");
+		this.load_all_modules();
 		if (this.provider_list == null)
 			debug("no providers found!");
 
 		foreach (unowned EnchantProvider provider in this.provider_list) {
 			debug("provider %s", provider.describe(provider));
 
-			foreach (string tag in provider.list_dicts(provider)) {
+			foreach (string tag in this.discovery_index.list_dicts(provider)) {
 				if (tag == null) {
 					this.error = @"null entry in dictionaries returned by $(provider.identify(provider))";
 					continue;
 				}
 				debug("tag %s", tag);
-				var providers = this.get_ordered_providers(tag);
-				int this_priority = providers.index(provider);
+				unowned var providers = this.get_ordered_providers(tag);
+				int this_priority = provider_priority(providers, provider);
 				debug("priority %d", this_priority);
 				if (this_priority != -1) {
 					int min_priority = this_priority + 1;
 					unowned var prov = tag_map.lookup(tag);
 					if (prov != null)
-						min_priority = providers.index(prov);
+						min_priority = provider_priority(providers, prov);
 					if (this_priority < min_priority)
 						tag_map.insert(tag, provider);
 				}
@@ -369,8 +635,9 @@ public class EnchantBroker {
 
 	int _dict_exists(string tag)
 	{
+		this.load_all_modules();
 		foreach (unowned EnchantProvider provider in this.provider_list)
-			if (provider._dictionary_exists(tag) != 0)
+			if (this.discovery_index.dictionary_exists(provider, tag))
 				return 1;
 		return 0;
 	}
@@ -410,6 +677,14 @@ public class EnchantBroker {
 	public void free_dict(EnchantDict? session) {
 		if (session == null)
 			return;
+		if (session.shared_key != null) {
+			unowned EnchantSharedDict? shared = this.shared_dicts.lookup(session.shared_key);
+			if (shared != null) {
+				shared.users--;
+				if (shared.users == 0)
+					this.shared_dicts.remove(session.shared_key);
+			}
+		}
 		this.sessions.remove(session);
 		this.clear_error();
 	}
@@ -0,0 +1,189 @@
+/* libenchant: Caches of provider results
+ * Copyright (C) 2026 Reuben Thomas <rrt@sc3d.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along along with this program; if not, see
+ * <https://www.gnu.org/licenses/>.
+ *
+ * In addition, as a special exception, the copyright holders
+ * give permission to link the code of this program with
+ * non-LGPL Spelling Provider libraries (eg: a MSFT Office
+ * spell checker backend) and distribute linked combinations including
+ * the two.  You must obey the GNU Lesser General Public License in all
+ * respects for all of the code used other than said providers.  If you modify
+ * this file, you may extend this exception to your version of the
+ * file, but you are not obligated to do so.  If you do not wish to
+ * do so, delete this exception statement from your version.
+ */
+
+/**
+ *  A bounded cache of provider check results, evicted with the CLOCK
+ *  algorithm (an approximation of LRU that needs no list reordering on a
+ *  hit).  A lookup only updates the statistics and the referenced flags,
+ *  atomically, so lookups may run concurrently with each other, though not
+ *  with other methods.
+ */
+public class EnchantCheckCache {
+	string?[] words;
+	int[] results;
+	int[] referenced;
+	int hand = 0;
+	int used = 0;
+	HashTable<unowned string, int> index; /* word -> slot + 1 */
+
+	public uint hits = 0;
+	public uint misses = 0;
+
+	public EnchantCheckCache(int size) {
+		this.words = new string?[size];
+		this.results = new int[size];
+		this.referenced = new int[size];
+		this.index = new HashTable<unowned string, int>(str_hash, str_equal);
+	}
+
+	public bool lookup(string word, out int result) {
+		int slot = this.index.lookup(word) - 1;
+		if (slot < 0) {
+			AtomicUint.inc(ref this.misses);
+			result = -1;
+			return false;
+		}
+
+		AtomicUint.inc(ref this.hits);
+		AtomicInt.set(ref this.referenced[slot], 1);
+		result = this.results[slot];
+		return true;
+	}
+
+	public void insert(string word, int result) {
+		if (this.words.length == 0 || this.index.contains(word))
+			return;
+
+		int slot;
+		if (this.used < this.words.length)
+			slot = this.used++;
+		else {
+			/* Find a slot that has not been referenced since the hand last
+			   passed it. */
+			while (this.referenced[this.hand] != 0) {
+				this.referenced[this.hand] = 0;
+				this.hand = (this.hand + 1) % this.words.length;
+			}
+			slot = this.hand;
+			this.hand = (this.hand + 1) % this.words.length;
+			this.index.remove(this.words[slot]);
+		}
+
+		this.words[slot] = word;
+		this.results[slot] = result;
+		this.referenced[slot] = 0;
+		this.index.insert(this.words[slot], slot + 1);
+	}
+
+	public void clear() {
+		this.index.remove_all();
+		for (int i = 0; i < this.used; i++)
+			this.words[i] = null;
+		this.used = 0;
+		this.hand = 0;
+	}
+}
+
+[Compact]
+class EnchantSuggestCacheEntry {
+	public string[] suggs;
+	public uint generation;
+	public size_t size;
+	public int referenced;
+}
+
+/**
+ *  A cache of filtered suggestions, bounded by the approximate number of
+ *  bytes it uses.  Each entry records the generation of the dictionary's
+ *  session and word lists when it was made, and is ignored once that
+ *  changes.  Entries are evicted in FIFO order, but referenced entries get
+ *  a second chance, as in CLOCK.  As with EnchantCheckCache, lookups may
+ *  run concurrently with each other.
+ */
+public class EnchantSuggestCache {
+	size_t max_size;
+	size_t size = 0;
+	HashTable<string, EnchantSuggestCacheEntry> entries;
+	Queue<string> order;
+
+	public uint hits = 0;
+	public uint misses = 0;
+
+	public EnchantSuggestCache(size_t max_size) {
+		this.max_size = max_size;
+		this.entries = new HashTable<string, EnchantSuggestCacheEntry>(str_hash, str_equal);
+		this.order = new Queue<string>();
+	}
+
+	static size_t entry_size(string word, string[] suggs) {
+		size_t size = word.length + 1 + (suggs.length + 1) * sizeof(void *);
+		foreach (unowned string sugg in suggs)
+			size += sugg.length + 1;
+		return size;
+	}
+
+	/* Return a copy of the cached suggestions for word, or null. */
+	public string[]? lookup(string word, uint generation) {
+		unowned EnchantSuggestCacheEntry? entry = this.entries.lookup(word);
+		if (entry == null || entry.generation != generation) {
+			AtomicUint.inc(ref this.misses);
+			return null;
+		}
+
+		AtomicUint.inc(ref this.hits);
+		AtomicInt.set(ref entry.referenced, 1);
+		return entry.suggs;
+	}
+
+	public void insert(string word, uint generation, string[] suggs) {
+		size_t size = entry_size(word, suggs);
+		if (size > this.max_size)
+			return;
+
+		unowned EnchantSuggestCacheEntry? old = this.entries.lookup(word);
+		if (old != null) {
+			/* Replace a stale entry in place. */
+			this.size -= old.size;
+			old.suggs = suggs;
+			old.generation = generation;
+			old.size = size;
+			this.size += size;
+		} else {
+			var entry = new EnchantSuggestCacheEntry();
+			entry.suggs = suggs;
+			entry.generation = generation;
+			entry.size = size;
+			entry.referenced = 0;
+			this.entries.insert(word, (owned)entry);
+			this.order.push_tail(word);
+			this.size += size;
+		}
+
+		while (this.size > this.max_size) {
+			string key = this.order.pop_head();
+			unowned EnchantSuggestCacheEntry victim = this.entries.lookup(key);
+			if (victim.referenced != 0) {
+				victim.referenced = 0;
+				this.order.push_tail(key);
+			} else {
+				this.size -= victim.size;
+				this.entries.remove(key);
+			}
+		}
+	}
+}
@@ -27,9 +27,87 @@
  * do so, delete this exception statement from your version.
  */
 
+/* The suggestions returned by one child of a composite dictionary. */
+[Compact]
+class EnchantChildSuggestions {
+	public string[]? suggs;
+}
+
+/* A call to all the children of a composite dictionary in parallel mode,
+   shared between the calling thread and the tasks on the worker pool. */
+class EnchantCompositeCall {
+	public Mutex mutex;
+	public Cond cond;
+	public int pending;
+	public bool found = false; /* a child has found the word being checked */
+	public int[] check_results;
+	public EnchantChildSuggestions?[] suggest_results;
+	public unowned EnchantBroker broker;
+
+	public EnchantCompositeCall(EnchantBroker broker, int n_children) {
+		this.broker = broker;
+		this.pending = n_children;
+		this.check_results = new int[n_children];
+		for (int i = 0; i < n_children; i++)
+			this.check_results[i] = -1;
+		this.suggest_results = new EnchantChildSuggestions?[n_children];
+	}
+}
+
+[Compact]
+class EnchantCompositeTask {
+	public EnchantDict? session;
+	public int index;
+	public string word;
+	public bool suggest;
+	public EnchantCompositeCall call;
+}
+
+void run_composite_task(owned EnchantCompositeTask task) {
+	EnchantCompositeCall call = task.call;
+
+	/* Once a child has found the word, there is no need to check it in
+	   the others. */
+	call.mutex.lock();
+	bool cancelled = call.found;
+	call.mutex.unlock();
+
+	int found = -1;
+	var suggestions = new EnchantChildSuggestions();
+	if (task.suggest)
+		suggestions.suggs = task.session.suggest(task.word, -1);
+	else if (!cancelled)
+		found = task.session.check(task.word, -1);
+
+	/* Drop our reference before letting the broker be freed. */
+	task.session = null;
+
+	call.mutex.lock();
+	if (task.suggest)
+		call.suggest_results[task.index] = (owned)suggestions;
+	else {
+		call.check_results[task.index] = found;
+		if (found == 0)
+			call.found = true;
+	}
+	call.pending--;
+	call.cond.broadcast();
+	call.mutex.unlock();
+
+	call.broker.task_finished();
+}
+
 public class EnchantCompositeDict : EnchantProviderDict {
 	unowned EnchantBroker broker;
 	public SList<weak EnchantDict> session_list;
+	/* If set, calls are made to the children in parallel on the pool. */
+	public bool parallel = false;
+	/* The maximum number of merged suggestions, or 0 for no limit. */
+	public real_size_t max_suggestions = 0;
+
+	/* Worker threads shared by all composite dictionaries. */
+	static ThreadPool<EnchantCompositeTask>? pool = null;
+	static Mutex pool_mutex;
 
 	public EnchantCompositeDict(EnchantBroker broker, owned SList<weak EnchantDict> session_list, string tag) {
 		base(null, tag);
@@ -40,12 +118,57 @@ public class EnchantCompositeDict : EnchantProviderDict {
 		this.add_to_session_method = composite_dict_add_to_session;
 		this.remove_from_session_method = composite_dict_remove_from_session;
 	}
+
+	static unowned ThreadPool<EnchantCompositeTask>? get_pool() {
+		pool_mutex.lock();
+		if (pool == null) {
+			try {
+				pool = new ThreadPool<EnchantCompositeTask>.with_owned_data(
+					run_composite_task, (int)get_num_processors(), false);
+			} catch (ThreadError e) {
+				warning("could not create composite dictionary thread pool: %s", e.message);
+			}
+		}
+		pool_mutex.unlock();
+		return pool;
+	}
+
+	/* Start checking word, or getting suggestions for it, in each child
+	   on the pool.  Returns null if the pool is not available. */
+	public EnchantCompositeCall? dispatch(string word, bool suggest) {
+		unowned ThreadPool<EnchantCompositeTask>? pool = get_pool();
+		if (pool == null)
+			return null;
+
+		var call = new EnchantCompositeCall(this.broker, (int)this.session_list.length());
+		int i = 0;
+		foreach (EnchantDict session in this.session_list) {
+			var task = new EnchantCompositeTask();
+			task.session = session;
+			task.index = i++;
+			task.word = word;
+			task.suggest = suggest;
+			task.call = call;
+			this.broker.task_started();
+			try {
+				pool.add((owned)task);
+			} catch (ThreadError e) {
+				/* The task is still queued, and will be run once a
+				   thread is available. */
+				warning("could not start composite dictionary thread: %s", e.message);
+			}
+		}
+		return call;
+	}
 }
 
 int composite_dict_check(EnchantProviderDict? self, string? word_buf, real_size_t len) {
 	if (self == null || word_buf == null)
 		return -1;
-	string word = buf_to_utf8_string(word_buf, (real_ssize_t)len);
+	/* The session passes a word that ends at len, so it need not be
+	   copied to terminate it, here or in the children. */
+	string? word_copy;
+	unowned string? word = buf_to_utf8_string(word_buf, -1, out word_copy);
 	if (word == null)
 		return -1;
 
@@ -53,8 +176,27 @@ int composite_dict_check(EnchantProviderDict? self, string? word_buf, real_size_
 	// Signal error (-1) if and only if all dictionaries error.
 	var cdict = (EnchantCompositeDict)(self);
 	int err = -1;
+	EnchantCompositeCall? call = null;
+	if (cdict.parallel)
+		call = cdict.dispatch(word, false);
+	if (call != null) {
+		/* Return as soon as one child finds the word; the others are left
+		   to finish by themselves. */
+		call.mutex.lock();
+		while (!call.found && call.pending > 0)
+			call.cond.wait(call.mutex);
+		if (call.found)
+			err = 0;
+		else
+			foreach (int found in call.check_results)
+				if (found == 1)
+					err = 1;
+		call.mutex.unlock();
+		return err;
+	}
+
 	foreach (EnchantDict session in cdict.session_list) {
-		int found = session.check(word, (real_ssize_t)len);
+		int found = session.check(word, -1);
 		if (found == 0)
 			return 0;
 		if (found == 1)
@@ -63,33 +205,73 @@ int composite_dict_check(EnchantProviderDict? self, string? word_buf, real_size_
 	return err;
 }
 
-[CCode (array_length_pos = 4, array_length_type = "size_t")]
-string[]? composite_dict_suggest(EnchantProviderDict me, string word, real_size_t len) {
-	var cdict = (EnchantCompositeDict)(me);
+/* Merge the suggestions of the children, taking the best remaining
+   suggestion of each child in turn and skipping duplicates, until max
+   suggestions (if not 0) have been found.  Returns null if every child
+   returned null. */
+string[]? merge_suggestions(EnchantChildSuggestions?[] results, real_size_t max) {
 	var error = true;
-	var res = new Array<string>();
-	foreach (EnchantDict dict in cdict.session_list) {
-		var suggs = dict.suggest(word, (real_ssize_t)len);
-		if (suggs != null) {
+	int longest = 0;
+	foreach (unowned EnchantChildSuggestions suggestions in results) {
+		if (suggestions.suggs != null) {
 			error = false;
-			if (suggs.length > 0)
-				for (real_size_t i = 0; i < suggs.length; i++)
-					res.append_val(suggs[i]);
+			longest = int.max(longest, suggestions.suggs.length);
 		}
 	}
 	if (error == true)
 		return null;
+
+	var res = new Array<string>();
+	var seen = new GenericSet<unowned string>(str_hash, str_equal);
+	for (int rank = 0; rank < longest; rank++) {
+		foreach (unowned EnchantChildSuggestions suggestions in results) {
+			if (max > 0 && res.length >= max)
+				return res.steal();
+			if (suggestions.suggs == null || rank >= suggestions.suggs.length)
+				continue;
+			unowned string sugg = suggestions.suggs[rank];
+			if (sugg in seen)
+				continue;
+			seen.add(sugg);
+			res.append_val(sugg);
+		}
+	}
 	return res.steal();
 }
 
+[CCode (array_length_pos = 4, array_length_type = "size_t")]
+string[]? composite_dict_suggest(EnchantProviderDict me, string word, real_size_t len) {
+	var cdict = (EnchantCompositeDict)(me);
+	EnchantChildSuggestions?[] results;
+	EnchantCompositeCall? call = null;
+	if (cdict.parallel)
+		call = cdict.dispatch(word.substring(0, (long)len), true);
+	if (call != null) {
+		call.mutex.lock();
+		while (call.pending > 0)
+			call.cond.wait(call.mutex);
+		call.mutex.unlock();
+		results = (owned)call.suggest_results;
+	} else {
+		results = new EnchantChildSuggestions?[cdict.session_list.length()];
+		int i = 0;
+		foreach (EnchantDict dict in cdict.session_list) {
+			results[i] = new EnchantChildSuggestions();
+			results[i].suggs = dict.suggest(word, -1);
+			i++;
+		}
+	}
+	return merge_suggestions(results, cdict.max_suggestions);
+}
+
 void composite_dict_add_to_session(EnchantProviderDict me, string word, real_size_t len) {
 	var cdict = (EnchantCompositeDict)(me);
 	assert(cdict.session_list.length() > 0);
-	cdict.session_list.data.add_to_session(word, (real_ssize_t)len);
+	cdict.session_list.data.add_to_session(word, -1);
 }
 
 void composite_dict_remove_from_session(EnchantProviderDict me, string word, real_size_t len) {
 	var cdict = (EnchantCompositeDict)(me);
 	assert(cdict.session_list.length() > 0);
-	cdict.session_list.data.remove_from_session(word, (real_ssize_t)len);
+	cdict.session_list.data.remove_from_session(word, -1);
 }
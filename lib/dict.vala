@@ -28,19 +28,54 @@
  * do so, delete this exception statement from your version.
  */
 
+/* Whether the session or word lists include or exclude a word. */
+[CCode (has_type_id = false)]
+enum EnchantWordStatus {
+	UNKNOWN,
+	INCLUDED,
+	EXCLUDED
+}
+
 public class EnchantDict {
-	public GenericSet<string> session_include;
-	public GenericSet<string> session_exclude;
+	/* The words added to or removed from the session; a word is in at most
+	   one of the two, so they are kept in one table. */
+	HashTable<string, EnchantWordStatus> session;
 	public EnchantPWL pwl;
 	public EnchantPWL exclude_pwl;
 	EnchantProviderDict dict;
+	EnchantCheckCache? check_cache = null;
+	EnchantSuggestCache? suggest_cache = null;
+	/* The maximum number of suggestions returned, or 0 for no limit. */
+	real_size_t max_suggestions = 0;
+	/* Incremented whenever the session or word lists change.  Accessed
+	   atomically. */
+	uint generation = 0;
+
+	/* In lazy_pwl mode, the words of the personal word list are not added
+	   to the session as they are read, but passed to the provider together
+	   when it is next asked for suggestions; pwl_pending is set when they
+	   have changed since, and is accessed atomically.  provider_pwl_words
+	   holds the words last passed. */
+	internal bool lazy_pwl = false;
+	internal int pwl_pending = 0;
+	GenericSet<string>? provider_pwl_words = null;
+
+	/* In concurrent mode, state_lock guards the session word sets and the
+	   word lists, and cache_lock guards the caches; cache lookups only
+	   need the reader lock.  Calls to the provider are serialised by the
+	   provider dictionary if its provider requires it. */
+	bool concurrent = false;
+	RWLock state_lock;
+	RWLock cache_lock;
 
 	public string personal_filename;
 	public string exclude_filename;
+	/* The provider dictionary is shared with other sessions; see
+	   EnchantBroker.request_provider_dict. */
+	public string? shared_key = null;
 
 	EnchantDict() {
-		this.session_include = new GenericSet<string>(str_hash, str_equal);
-		this.session_exclude = new GenericSet<string>(str_hash, str_equal);
+		this.session = new HashTable<string, EnchantWordStatus>(str_hash, str_equal);
 	}
 
 	public static EnchantDict with_implicit_pwl(EnchantProviderDict dict, string lang, string? pwl) {
@@ -69,16 +104,91 @@ public class EnchantDict {
 		return session;
 	}
 
-	bool excluded(string word) {
-		return !this.session_include.contains(word) &&
-			(this.session_exclude.contains(word) ||
-			 this.exclude_pwl.check(this, word, word.length) == 0);
+	void read_lock() {
+		if (this.concurrent)
+			this.state_lock.reader_lock();
+	}
+
+	void read_unlock() {
+		if (this.concurrent)
+			this.state_lock.reader_unlock();
+	}
+
+	void write_lock() {
+		if (this.concurrent)
+			this.state_lock.writer_lock();
+	}
+
+	void write_unlock() {
+		if (this.concurrent)
+			this.state_lock.writer_unlock();
+	}
+
+	void read_lock_caches() {
+		if (this.concurrent)
+			this.cache_lock.reader_lock();
 	}
 
-	bool contains(string word) {
-		return this.session_include.contains(word) ||
-			(this.pwl.check(this, word, word.length) == 0 &&
-			 this.exclude_pwl.check(this, word, word.length) != 0);
+	void read_unlock_caches() {
+		if (this.concurrent)
+			this.cache_lock.reader_unlock();
+	}
+
+	void lock_caches() {
+		if (this.concurrent)
+			this.cache_lock.writer_lock();
+	}
+
+	void unlock_caches() {
+		if (this.concurrent)
+			this.cache_lock.writer_unlock();
+	}
+
+	/* Reread the personal and exclude word lists if they have changed.
+	   Must be called before status(). */
+	void refresh_pwls() {
+		/* Readers only need the writer lock if there is something to
+		   reread. */
+		if (this.concurrent) {
+			this.read_lock();
+			bool stale = this.pwl.is_stale() || this.exclude_pwl.is_stale();
+			this.read_unlock();
+			if (!stale)
+				return;
+		}
+
+		this.write_lock();
+		bool changed = this.pwl.refresh_from_file(this);
+		if (this.exclude_pwl.refresh_from_file(this))
+			changed = true;
+		if (changed)
+			AtomicUint.inc(ref this.generation);
+		this.write_unlock();
+	}
+
+	/* The session takes precedence over the exclude list, which takes
+	   precedence over the personal word list.  Each is looked up at most
+	   once. */
+	EnchantWordStatus status(string word) {
+		EnchantWordStatus status = this.session.lookup(word);
+		if (status != EnchantWordStatus.UNKNOWN)
+			return status;
+		if (this.exclude_pwl.lookup(word) == 0)
+			return EnchantWordStatus.EXCLUDED;
+		if (this.pwl.lookup(word) == 0)
+			return EnchantWordStatus.INCLUDED;
+		return EnchantWordStatus.UNKNOWN;
+	}
+
+	/* Whether a word has been added to the session, or is in the personal
+	   word list but not the exclude list.  Unlike status(), removing a word
+	   from the session does not stop it counting as added to the personal
+	   word list, as enchant_dict_is_added has always behaved. */
+	bool added(string word) {
+		EnchantWordStatus status = this.session.lookup(word);
+		if (status == EnchantWordStatus.INCLUDED)
+			return true;
+		return this.pwl.lookup(word) == 0 && this.exclude_pwl.lookup(word) != 0;
 	}
 
 	public unowned string get_extra_word_characters() {
@@ -130,30 +240,184 @@ public class EnchantDict {
 	public int check(string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return -1;
-		string word = buf_to_utf8_string(word_buf, len);
+		string? word_copy;
+		unowned string? word = buf_to_utf8_string(word_buf, len, out word_copy);
 		if (word == null)
 			return -1;
 
 		this.clear_error();
+		this.refresh_pwls();
 
-		/* first, see if it's excluded */
-		if (this.excluded(word))
+		this.read_lock();
+		EnchantWordStatus status = this.status(word);
+		this.read_unlock();
+		if (status == EnchantWordStatus.EXCLUDED)
 			return 1;
-
-		/* then, see if it's in our pwl or session */
-		if (this.contains(word))
+		if (status == EnchantWordStatus.INCLUDED)
 			return 0;
 
-		return this.dict.check_method(this.dict, word, word.length);
+		return this.check_provider(word);
+	}
+
+	/* Check a word with the provider, using the check cache if enabled. */
+	int check_provider(string word) {
+		int result;
+		uint generation = AtomicUint.get(ref this.generation);
+		this.read_lock_caches();
+		bool cached = this.check_cache != null && this.check_cache.lookup(word, out result);
+		this.read_unlock_caches();
+		if (cached)
+			return result;
+
+		this.dict.begin_call();
+		result = this.dict.check_method(this.dict, word, word.length);
+		this.dict.end_call();
+		if (result >= 0)
+			this.cache_check_result(word, result, generation);
+		return result;
+	}
+
+	/* Cache a provider result, unless the provider's session may have
+	   changed since generation was read. */
+	void cache_check_result(string word, int result, uint generation) {
+		this.lock_caches();
+		if (this.check_cache != null && AtomicUint.get(ref this.generation) == generation)
+			this.check_cache.insert(word, result);
+		this.unlock_caches();
+	}
+
+	public void set_check_cache_size(real_size_t size) {
+		this.clear_error();
+
+		/* A composite dictionary's results depend on its sessions, so
+		   cache in each of them instead. */
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null) {
+			foreach (EnchantDict session in cdict.session_list)
+				session.set_check_cache_size(size);
+			return;
+		}
+
+		this.lock_caches();
+		this.check_cache = size > 0 ? new EnchantCheckCache((int)size) : null;
+		this.unlock_caches();
 	}
 
-	/* Filter out suggestions that are null, invalid UTF-8 or in the exclude
-	   list.  Returns a null-terminated array. */
+	public void get_check_cache_stats(out real_size_t hits, out real_size_t misses) {
+		this.clear_error();
+		hits = 0;
+		misses = 0;
+
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null) {
+			foreach (EnchantDict session in cdict.session_list) {
+				real_size_t session_hits, session_misses;
+				session.get_check_cache_stats(out session_hits, out session_misses);
+				hits += session_hits;
+				misses += session_misses;
+			}
+		} else {
+			this.read_lock_caches();
+			if (this.check_cache != null) {
+				hits = AtomicUint.get(ref this.check_cache.hits);
+				misses = AtomicUint.get(ref this.check_cache.misses);
+			}
+			this.read_unlock_caches();
+		}
+	}
+
+	/* The provider's results may change when words are added to or removed
+	   from its session. */
+	void invalidate_check_cache() {
+		this.lock_caches();
+		if (this.check_cache != null)
+			this.check_cache.clear();
+		this.unlock_caches();
+	}
+
+	public void check_many([CCode (array_length = false, type = "const char *const *")] string?[] words,
+						   [CCode (array_length = false, type = "const ssize_t *")] real_ssize_t[]? lens,
+						   real_size_t n,
+						   [CCode (array_length = false)] int[] results) {
+		if (words == null || results == null)
+			return;
+
+		this.clear_error();
+		this.refresh_pwls();
+
+		/* Answer what we can from the session and word lists, and collect
+		   the remaining words to pass to the provider in one go. */
+		string[] pending_words = {};
+		real_size_t[] pending_index = {};
+		uint generation = AtomicUint.get(ref this.generation);
+		this.read_lock();
+		this.read_lock_caches();
+		for (real_size_t i = 0; i < n; i++) {
+			real_ssize_t len = -1;
+			if (lens != null)
+				len = lens[i];
+			string? word_copy = null;
+			unowned string? word = null;
+			if (words[i] != null)
+				word = buf_to_utf8_string(words[i], len, out word_copy);
+
+			int result;
+			EnchantWordStatus status = EnchantWordStatus.UNKNOWN;
+			if (word == null)
+				results[i] = -1;
+			else if ((status = this.status(word)) == EnchantWordStatus.EXCLUDED)
+				results[i] = 1;
+			else if (status == EnchantWordStatus.INCLUDED)
+				results[i] = 0;
+			else if (this.check_cache != null && this.check_cache.lookup(word, out result))
+				results[i] = result;
+			else {
+				pending_words += word;
+				pending_index += i;
+			}
+		}
+		this.read_unlock_caches();
+		this.read_unlock();
+
+		if (pending_words.length == 0)
+			return;
+
+		this.dict.begin_call();
+		if (this.dict.check_many_method != null) {
+			var pending_lens = new real_size_t[pending_words.length];
+			var pending_results = new int[pending_words.length];
+			for (int j = 0; j < pending_words.length; j++)
+				pending_lens[j] = pending_words[j].length;
+			this.dict.check_many_method(this.dict, pending_words, pending_lens,
+										pending_words.length, pending_results);
+			for (int j = 0; j < pending_words.length; j++)
+				results[pending_index[j]] = pending_results[j];
+		} else {
+			for (int j = 0; j < pending_words.length; j++)
+				results[pending_index[j]] = this.dict.check_method(this.dict, pending_words[j], pending_words[j].length);
+		}
+		this.dict.end_call();
+
+		for (int j = 0; j < pending_words.length; j++)
+			if (results[pending_index[j]] >= 0)
+				this.cache_check_result(pending_words[j], results[pending_index[j]], generation);
+	}
+
+	/* Reject suggestions that are null, invalid UTF-8 or in the exclude
+	   list. */
+	bool accept_suggestion(string? sugg) {
+		return sugg != null && sugg.validate() && this.status(sugg) != EnchantWordStatus.EXCLUDED;
+	}
+
+	/* Filter suggestions with accept_suggestion.  Returns a null-terminated
+	   array. */
 	string[]? filter_suggestions(string[] suggs) {
 		var sb = new StrvBuilder();
+		this.read_lock();
 		foreach (string sugg in suggs)
-			if (sugg != null && sugg.validate() && !this.excluded(sugg))
+			if (this.accept_suggestion(sugg))
 				sb.add(sugg);
+		this.read_unlock();
 		return sb.end();
 	}
 
@@ -161,80 +425,489 @@ public class EnchantDict {
 	public string[]? suggest(string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return null;
-		string word = buf_to_utf8_string(word_buf, len);
+		string? word_copy;
+		unowned string? word = buf_to_utf8_string(word_buf, len, out word_copy);
 		if (word == null)
 			return null;
 
 		this.clear_error();
+		this.refresh_pwls();
 
-		/* Check for suggestions from provider dictionary */
-		string[]? dict_suggs = dict.suggest_method(dict, word, word.length);
+		string[]? suggs = this.suggest_word(word);
+		if (suggs != null && this.max_suggestions > 0 && suggs.length > this.max_suggestions)
+			suggs = suggs[0:(int)this.max_suggestions];
+		return suggs;
+	}
+
+	/* Get the filtered suggestions for a word from the provider, using the
+	   suggestion cache if enabled. */
+	string[]? suggest_word(string word) {
+		string[]? dict_suggs = null;
+		uint generation = AtomicUint.get(ref this.generation);
+		this.read_lock_caches();
+		if (this.suggest_cache != null)
+			dict_suggs = this.suggest_cache.lookup(word, generation);
+		this.read_unlock_caches();
 		if (dict_suggs != null)
+			return dict_suggs;
+
+		/* Check for suggestions from provider dictionary */
+		dict_suggs = this.suggest_provider(word);
+		if (dict_suggs != null) {
 			dict_suggs = this.filter_suggestions(dict_suggs);
+			this.lock_caches();
+			if (this.suggest_cache != null)
+				this.suggest_cache.insert(word, generation, dict_suggs);
+			this.unlock_caches();
+		}
 
 		return dict_suggs;
 	}
 
+	/* In lazy_pwl mode, bring the provider's session up to date with the
+	   personal word list. */
+	void update_provider_pwl() {
+		if (AtomicInt.get(ref this.pwl_pending) == 0)
+			return;
+
+		this.write_lock();
+		if (AtomicInt.compare_and_exchange(ref this.pwl_pending, 1, 0)) {
+			GenericSet<string> words = this.pwl.get_words();
+			/* A shared provider dictionary's session is not ours to change. */
+			if (this.shared_key == null) {
+				this.dict.begin_call();
+				if (this.provider_pwl_words != null && this.dict.remove_from_session_method != null)
+					foreach (unowned string word in this.provider_pwl_words)
+						if (!(word in words))
+							this.dict.remove_from_session_method(this.dict, word, word.length);
+				if (this.dict.add_to_session_method != null)
+					foreach (unowned string word in words)
+						if (this.provider_pwl_words == null || !(word in this.provider_pwl_words))
+							this.dict.add_to_session_method(this.dict, word, word.length);
+				this.dict.end_call();
+				this.invalidate_check_cache();
+			}
+			this.provider_pwl_words = (owned)words;
+			AtomicUint.inc(ref this.generation);
+		}
+		this.write_unlock();
+	}
+
+	string[]? suggest_provider(string word) {
+		this.update_provider_pwl();
+		this.dict.begin_call();
+		string[]? suggs = this.dict.suggest_method(this.dict, word, word.length);
+		this.dict.end_call();
+		return suggs;
+	}
+
+	public void set_concurrent(bool concurrent) {
+		this.clear_error();
+
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null) {
+			/* The members do their own locking. */
+			foreach (EnchantDict session in cdict.session_list)
+				session.set_concurrent(concurrent);
+		} else if (this.dict.provider != null && this.dict.provider.serialize_dict_calls &&
+				   this.shared_key == null) {
+			/* A shared dictionary's calls are always serialised; see
+			   EnchantBroker.request_provider_dict. */
+			this.dict.set_serialize_calls(concurrent);
+		}
+
+		this.concurrent = concurrent;
+	}
+
+	public void set_parallel(bool parallel) {
+		this.clear_error();
+
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict == null)
+			return;
+
+		/* The members are called from the worker threads. */
+		if (parallel)
+			foreach (EnchantDict session in cdict.session_list)
+				session.set_concurrent(true);
+		cdict.parallel = parallel;
+	}
+
+	public void set_max_suggestions(real_size_t max_suggestions) {
+		this.clear_error();
+
+		/* A composite dictionary stops merging once it has enough. */
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null)
+			cdict.max_suggestions = max_suggestions;
+		this.max_suggestions = max_suggestions;
+	}
+
+	public void set_pwl_refresh_interval(uint interval_ms) {
+		this.clear_error();
+
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null)
+			foreach (EnchantDict session in cdict.session_list)
+				session.set_pwl_refresh_interval(interval_ms);
+
+		this.write_lock();
+		this.pwl.refresh_interval = (int64)interval_ms * 1000;
+		this.exclude_pwl.refresh_interval = (int64)interval_ms * 1000;
+		this.write_unlock();
+	}
+
+	public void set_pwl_index(bool use_index) {
+		this.clear_error();
+
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null)
+			foreach (EnchantDict session in cdict.session_list)
+				session.set_pwl_index(use_index);
+
+		this.write_lock();
+		if (use_index) {
+			/* Personal words are looked up in the index rather than passed
+			   to the provider, so take back any it has already been
+			   given, lest they outlive their removal from the list. */
+			GenericSet<string>? passed = this.lazy_pwl ? this.provider_pwl_words :
+				(this.pwl.passes_words_to_session() ? this.pwl.get_words() : null);
+			if (passed != null)
+				foreach (unowned string word in passed)
+					this.provider_remove(word);
+			this.provider_pwl_words = null;
+			AtomicInt.set(ref this.pwl_pending, 0);
+		}
+		this.pwl.set_use_index(use_index);
+		this.exclude_pwl.set_use_index(use_index);
+		this.write_unlock();
+		AtomicUint.inc(ref this.generation);
+	}
+
+	public void set_lazy_pwl(bool lazy_pwl) {
+		this.clear_error();
+
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null)
+			foreach (EnchantDict session in cdict.session_list)
+				session.set_lazy_pwl(lazy_pwl);
+
+		this.write_lock();
+		bool was_lazy = this.lazy_pwl;
+		if (lazy_pwl && !was_lazy) {
+			/* The words read so far have already been passed to the
+			   provider; record them, so that they are taken back from it
+			   if they leave the list. */
+			this.provider_pwl_words = this.pwl.passes_words_to_session() ?
+				this.pwl.get_words() : new GenericSet<string>(str_hash, str_equal);
+			AtomicInt.set(ref this.pwl_pending, 0);
+		}
+		this.lazy_pwl = lazy_pwl;
+		this.write_unlock();
+
+		/* Words will be passed to the provider as they are read again, so
+		   first bring it up to date with the list. */
+		if (was_lazy && !lazy_pwl) {
+			AtomicInt.set(ref this.pwl_pending, 1);
+			this.update_provider_pwl();
+			this.write_lock();
+			this.provider_pwl_words = null;
+			this.write_unlock();
+		}
+	}
+
+	public void set_suggest_cache_size(real_size_t max_size) {
+		this.clear_error();
+
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null) {
+			foreach (EnchantDict session in cdict.session_list)
+				session.set_suggest_cache_size(max_size);
+			return;
+		}
+
+		this.lock_caches();
+		this.suggest_cache = max_size > 0 ? new EnchantSuggestCache(max_size) : null;
+		this.unlock_caches();
+	}
+
+	public void get_suggest_cache_stats(out real_size_t hits, out real_size_t misses) {
+		this.clear_error();
+		hits = 0;
+		misses = 0;
+
+		var cdict = this.dict as EnchantCompositeDict;
+		if (cdict != null) {
+			foreach (EnchantDict session in cdict.session_list) {
+				real_size_t session_hits, session_misses;
+				session.get_suggest_cache_stats(out session_hits, out session_misses);
+				hits += session_hits;
+				misses += session_misses;
+			}
+		} else {
+			this.read_lock_caches();
+			if (this.suggest_cache != null) {
+				hits = AtomicUint.get(ref this.suggest_cache.hits);
+				misses = AtomicUint.get(ref this.suggest_cache.misses);
+			}
+			this.read_unlock_caches();
+		}
+	}
+
+	public char*** suggest_many([CCode (array_length = false, type = "const char *const *")] string?[] words,
+								[CCode (array_length = false, type = "const ssize_t *")] real_ssize_t[]? lens,
+								real_size_t n,
+								[CCode (array_length = false)] real_size_t[]? out_n_suggs) {
+		if (words == null)
+			return null;
+
+		this.clear_error();
+		this.refresh_pwls();
+
+		/* Gather the accepted suggestions for all the words into one
+		   buffer, then build the result in a single allocation.  A
+		   negative count means the provider returned no list. */
+		var strings = new StringBuilder();
+		size_t[] offsets = {};
+		var counts = new ssize_t[(int)n];
+		size_t n_lists = 0;
+		for (real_size_t i = 0; i < n; i++) {
+			counts[i] = -1;
+
+			real_ssize_t len = -1;
+			if (lens != null)
+				len = lens[i];
+			string? word_copy = null;
+			unowned string? word = null;
+			if (words[i] != null)
+				word = buf_to_utf8_string(words[i], len, out word_copy);
+			if (word == null)
+				continue;
+
+			/* Cached suggestions are already filtered. */
+			this.read_lock_caches();
+			bool filtered = this.suggest_cache != null;
+			this.read_unlock_caches();
+			string[]? dict_suggs;
+			if (filtered)
+				dict_suggs = this.suggest_word(word);
+			else
+				dict_suggs = this.suggest_provider(word);
+			if (dict_suggs == null)
+				continue;
+
+			counts[i] = 0;
+			n_lists++;
+			this.read_lock();
+			foreach (unowned string? sugg in dict_suggs) {
+				if (this.max_suggestions > 0 && counts[i] >= this.max_suggestions)
+					break;
+				if (filtered || this.accept_suggestion(sugg)) {
+					offsets += (size_t)strings.len;
+					strings.append(sugg);
+					strings.append_c('\0');
+					counts[i]++;
+				}
+			}
+			this.read_unlock();
+		}
+
+		/* The block holds the n list pointers, then the null-terminated
+		   lists, then the strings. */
+		size_t lists_start = (size_t)n * sizeof(void *);
+		size_t strings_start = lists_start + (offsets.length + n_lists) * sizeof(void *);
+		/* The block is empty only when n is 0, and malloc(0) may return
+		   null, which would look like a failure. */
+		size_t block_size = strings_start + (size_t)strings.len;
+		char *block = (char *)malloc(block_size > 0 ? block_size : 1);
+		if (block == null)
+			return null;
+		Memory.copy(block + strings_start, (void *)strings.str, (size_t)strings.len);
+
+		char ***lists = (char ***)block;
+		char **slot = (char **)(block + lists_start);
+		int k = 0;
+		for (real_size_t i = 0; i < n; i++) {
+			if (counts[i] < 0) {
+				if (out_n_suggs != null)
+					out_n_suggs[i] = 0;
+				lists[i] = null;
+				continue;
+			}
+			if (out_n_suggs != null)
+				out_n_suggs[i] = counts[i];
+			lists[i] = slot;
+			for (ssize_t j = 0; j < counts[i]; j++) {
+				*slot = block + strings_start + offsets[k++];
+				slot++;
+			}
+			*slot = null;
+			slot++;
+		}
+
+		return lists;
+	}
+
 	public void add(string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return;
+		this.write_lock();
 		this.pwl.add(this, word_buf, len);
 		this.exclude_pwl.remove(this, word_buf, len);
+		this.write_unlock();
 		this.add_to_session(word_buf, len);
 	}
 
+	/* The valid, non-empty words among the first n of words, with lengths
+	   as for check_many. */
+	static string[] valid_words(string?[] words, real_ssize_t[]? lens, real_size_t n) {
+		string[] valid = {};
+		for (real_size_t i = 0; i < n; i++) {
+			if (words[i] == null)
+				continue;
+			string? word_copy;
+			unowned string? word = buf_to_utf8_string(words[i], lens != null ? lens[i] : -1, out word_copy);
+			if (word != null && word.length > 0)
+				valid += word;
+		}
+		return valid;
+	}
+
+	public void add_many([CCode (array_length = false, type = "const char *const *")] string?[] words,
+						 [CCode (array_length = false, type = "const ssize_t *")] real_ssize_t[]? lens,
+						 real_size_t n) {
+		if (words == null)
+			return;
+		string[] valid = valid_words(words, lens, n);
+		this.clear_error();
+		this.write_lock();
+		this.pwl.add_many(this, valid);
+		this.exclude_pwl.remove_many(this, valid);
+		foreach (unowned string word in valid)
+			this.session_add(word);
+		this.write_unlock();
+	}
+
 	public void add_to_session(string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return;
-		string word = buf_to_utf8_string(word_buf, len);
+		string? word_copy;
+		unowned string? word = buf_to_utf8_string(word_buf, len, out word_copy);
 		if (word == null)
 			return;
 		this.clear_error();
-		this.session_exclude.remove(word);
-		this.session_include.add(word);
-		if (dict.add_to_session_method != null)
+		this.write_lock();
+		this.session_add(word);
+		this.write_unlock();
+	}
+
+	/* Add a valid word to the session.  In concurrent mode, the caller
+	   must hold the writer lock. */
+	internal void session_add(string word) {
+		this.session.insert(word, EnchantWordStatus.INCLUDED);
+		this.provider_add(word);
+	}
+
+	/* Add a valid word to the provider's session only, as is done for the
+	   words of the personal word list, which must not take precedence over
+	   the exclude list as session words do.  In concurrent mode, the caller
+	   must hold the writer lock. */
+	internal void provider_add(string word) {
+		AtomicUint.inc(ref this.generation);
+		/* A shared provider dictionary's session is not ours to change. */
+		if (dict.add_to_session_method != null && this.shared_key == null) {
+			dict.begin_call();
 			dict.add_to_session_method(dict, word, word.length);
+			dict.end_call();
+			this.invalidate_check_cache();
+		}
 	}
 
 	public int is_added(string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return 0;
-		string word = buf_to_utf8_string(word_buf, len);
+		string? word_copy;
+		unowned string? word = buf_to_utf8_string(word_buf, len, out word_copy);
 		if (word == null)
 			return 0;
 		this.clear_error();
-		return this.contains(word) ? 1 : 0;
+		this.refresh_pwls();
+		this.read_lock();
+		bool is_contained = this.added(word);
+		this.read_unlock();
+		return is_contained ? 1 : 0;
 	}
 
 	public void remove(string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return;
+		this.write_lock();
 		this.pwl.remove(this, word_buf, len);
 		this.exclude_pwl.add(this, word_buf, len);
+		this.write_unlock();
 		this.remove_from_session(word_buf, len);
 	}
 
+	public void remove_many([CCode (array_length = false, type = "const char *const *")] string?[] words,
+							[CCode (array_length = false, type = "const ssize_t *")] real_ssize_t[]? lens,
+							real_size_t n) {
+		if (words == null)
+			return;
+		string[] valid = valid_words(words, lens, n);
+		this.clear_error();
+		this.write_lock();
+		this.pwl.remove_many(this, valid);
+		this.exclude_pwl.add_many(this, valid);
+		foreach (unowned string word in valid)
+			this.session_remove(word);
+		this.write_unlock();
+	}
+
 	public void remove_from_session(string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return;
-		string word = buf_to_utf8_string(word_buf, len);
+		string? word_copy;
+		unowned string? word = buf_to_utf8_string(word_buf, len, out word_copy);
 		if (word == null)
 			return;
 		this.clear_error();
-		this.session_include.remove(word);
-		this.session_exclude.add(word);
-		if (dict.remove_from_session_method != null)
+		this.write_lock();
+		this.session_remove(word);
+		this.write_unlock();
+	}
+
+	/* Remove a valid word from the session.  In concurrent mode, the
+	   caller must hold the writer lock. */
+	internal void session_remove(string word) {
+		this.session.insert(word, EnchantWordStatus.EXCLUDED);
+		this.provider_remove(word);
+	}
+
+	/* Remove a valid word from the provider's session only; see
+	   provider_add. */
+	internal void provider_remove(string word) {
+		AtomicUint.inc(ref this.generation);
+		if (dict.remove_from_session_method != null && this.shared_key == null) {
+			dict.begin_call();
 			dict.remove_from_session_method(dict, word, word.length);
+			dict.end_call();
+			this.invalidate_check_cache();
+		}
 	}
 
 	public int is_removed(string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return 0;
-		string word = buf_to_utf8_string(word_buf, len);
+		string? word_copy;
+		unowned string? word = buf_to_utf8_string(word_buf, len, out word_copy);
 		if (word == null)
 			return 0;
 		this.clear_error();
-		return this.excluded(word) ? 1 : 0;
+		this.refresh_pwls();
+		this.read_lock();
+		bool is_excluded = this.status(word) == EnchantWordStatus.EXCLUDED;
+		this.read_unlock();
+		return is_excluded ? 1 : 0;
 	}
 
 	/* Stub for obsolete API. */
@@ -246,6 +919,11 @@ public class EnchantDict {
 		strfreev((string[])(owned)string_list);
 	}
 
+	public void free_string_lists(char ***string_lists) {
+		this.clear_error();
+		free(string_lists);
+	}
+
 	public void describe(EnchantDictDescribeFn fn, void *user_data)
 	{
 		this.clear_error();
@@ -277,12 +955,12 @@ public class EnchantDict {
 	}
 
 	public unowned string get_error() {
-		return this.dict.error;
+		return this.dict.get_thread_error();
 	}
 
 	public void clear_error() {
 		if (this.dict != null) {
-			this.dict.error = null;
+			this.dict.clear_thread_error();
 		}
 	}
 }
@@ -0,0 +1,159 @@
+/* libenchant: Dictionary discovery index
+ * Copyright (C) 2026 Reuben Thomas <rrt@sc3d.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along along with this program; if not, see
+ * <https://www.gnu.org/licenses/>.
+ *
+ * In addition, as a special exception, the copyright holders
+ * give permission to link the code of this program with
+ * non-LGPL Spelling Provider libraries (eg: a MSFT Office
+ * spell checker backend) and distribute linked combinations including
+ * the two.  You must obey the GNU Lesser General Public License in all
+ * respects for all of the code used other than said providers.  If you modify
+ * this file, you may extend this exception to your version of the
+ * file, but you are not obligated to do so.  If you do not wish to
+ * do so, delete this exception statement from your version.
+ */
+
+/**
+ *  A persistent index of the dictionaries offered by providers that list
+ *  the directories they search.  A provider's entry is valid as long as
+ *  the directories and their modification times are unchanged, so that
+ *  dictionaries can be listed without rescanning the directories.
+ *
+ *  Existence probes are answered from a valid entry when it lists the
+ *  dictionary; on a miss or a stale entry, a provider's own
+ *  dictionary_exists method, if it has one, decides.  The file is kept in
+ *  the user cache directory, and is not written if that cannot be done.
+ */
+public class EnchantDiscoveryIndex {
+	string filename;
+	KeyFile? key_file = null;
+	bool read_only = false; /* the file cannot be written */
+
+	public EnchantDiscoveryIndex(string filename) {
+		this.filename = filename;
+	}
+
+	void load() {
+		if (this.key_file != null)
+			return;
+		this.key_file = new KeyFile();
+		try {
+			this.key_file.load_from_file(this.filename, KeyFileFlags.NONE);
+		} catch (Error e) {
+			debug("could not read dictionary index %s: %s", this.filename, e.message);
+		}
+	}
+
+	void save() {
+		if (this.read_only)
+			return;
+		/* Check first, rather than fail to write to a read-only home
+		   directory each time a provider is scanned. */
+		string dir = Path.get_dirname(this.filename);
+		if (DirUtils.create_with_parents(dir, 0700) != 0 ||
+			Posix.access(dir, Posix.W_OK) != 0) {
+			debug("dictionary index directory %s is not writable", dir);
+			this.read_only = true;
+			return;
+		}
+		try {
+			FileUtils.set_contents(this.filename, this.key_file.to_data());
+		} catch (FileError e) {
+			debug("could not write dictionary index %s: %s", this.filename, e.message);
+			this.read_only = true;
+		}
+	}
+
+	/* A stamp of the provider's dictionary directories and their
+	   modification times, which change when dictionaries are added to or
+	   removed from them, and the newest of those times. */
+	static string dirs_stamp(EnchantProvider provider, out int64 newest) {
+		var stamp = new StringBuilder();
+		newest = 0;
+		foreach (string dir in provider.list_dict_dirs(provider)) {
+			int64 mtime = 0;
+			Posix.Stat stats;
+			if (Posix.stat(dir, out stats) == 0)
+				mtime = (int64)stats.st_mtime;
+			stamp.append_printf("%s\t%" + int64.FORMAT + "\n", dir, mtime);
+			if (mtime > newest)
+				newest = mtime;
+		}
+		return stamp.str;
+	}
+
+	/* The provider's dictionaries according to the index, or null if its
+	   entry is missing or stale. */
+	string[]? lookup(EnchantProvider provider, string stamp, int64 newest) {
+		/* The entry must have been made after the directories were last
+		   modified, or a later change in the same second would go
+		   unnoticed. */
+		string name = provider.identify(provider);
+		this.load();
+		try {
+			if (this.key_file.get_string(name, "stamp") == stamp &&
+				newest < this.key_file.get_int64(name, "scanned"))
+				return this.key_file.get_string_list(name, "dicts");
+		} catch (KeyFileError e) {}
+		return null;
+	}
+
+	public string[] list_dicts(EnchantProvider provider) {
+		if (provider.list_dict_dirs == null)
+			return provider.list_dicts(provider);
+
+		int64 newest;
+		string stamp = dirs_stamp(provider, out newest);
+		string[]? cached = this.lookup(provider, stamp, newest);
+		if (cached != null)
+			return cached;
+
+		string[] dicts = provider.list_dicts(provider);
+		foreach (unowned string? dict in dicts)
+			if (dict == null)
+				return dicts;
+		string name = provider.identify(provider);
+		this.key_file.set_string(name, "stamp", stamp);
+		this.key_file.set_int64(name, "scanned", get_real_time() / 1000000);
+		this.key_file.set_string_list(name, "dicts", dicts);
+		this.save();
+		return dicts;
+	}
+
+	public bool dictionary_exists(EnchantProvider provider, string tag) {
+		if (provider.list_dict_dirs == null)
+			return provider._dictionary_exists(tag) != 0;
+
+		int64 newest;
+		string[]? cached = this.lookup(provider, dirs_stamp(provider, out newest), newest);
+		if (cached != null) {
+			foreach (unowned string dict in cached)
+				if (dict == tag)
+					return true;
+		}
+
+		/* The provider may know of dictionaries that it does not list. */
+		if (provider.dictionary_exists != null)
+			return provider.dictionary_exists(provider, tag) != 0;
+		if (cached != null)
+			return false;
+
+		foreach (unowned string dict in this.list_dicts(provider))
+			if (dict == tag)
+				return true;
+		return false;
+	}
+}
@@ -73,11 +73,12 @@ namespace enchant
 				enchant_broker_free_dict (m_broker, m_dict);
 			}
 
+			// Words are passed with length -1, as they are nul-terminated,
+			// so that enchant need not copy them to terminate them.
 			bool check (const std::string & utf8word) {
 				int val;
 
-				val = enchant_dict_check (m_dict, utf8word.c_str(),
-							  utf8word.size());
+				val = enchant_dict_check (m_dict, utf8word.c_str(), -1);
 				if (val == 0)
 					return true;
 				else if (val > 0)
@@ -96,8 +97,7 @@ namespace enchant
 
 				out_suggestions.clear ();
 
-				suggs = enchant_dict_suggest (m_dict, utf8word.c_str(),
-							      utf8word.size(), &n_suggs);
+				suggs = enchant_dict_suggest (m_dict, utf8word.c_str(), -1, &n_suggs);
 
 				if (suggs && n_suggs) {
 					out_suggestions.reserve(n_suggs);
@@ -117,40 +117,34 @@ namespace enchant
 			}
 
 			void add (const std::string & utf8word) {
-				enchant_dict_add (m_dict, utf8word.c_str(),
-							 utf8word.size());
+				enchant_dict_add (m_dict, utf8word.c_str(), -1);
 			}
 
 			void add_to_session (const std::string & utf8word) {
-				enchant_dict_add_to_session (m_dict, utf8word.c_str(),
-							     utf8word.size());
+				enchant_dict_add_to_session (m_dict, utf8word.c_str(), -1);
 			}
 
 			bool is_added (const std::string & utf8word) {
-				return enchant_dict_is_added (m_dict, utf8word.c_str(),
-							      utf8word.size());
+				return enchant_dict_is_added (m_dict, utf8word.c_str(), -1);
 			}
 
 			void remove (const std::string & utf8word) {
-				enchant_dict_remove (m_dict, utf8word.c_str(),
-							 utf8word.size());
+				enchant_dict_remove (m_dict, utf8word.c_str(), -1);
 			}
 
 			void remove_from_session (const std::string & utf8word) {
-				enchant_dict_remove_from_session (m_dict, utf8word.c_str(),
-							     utf8word.size());
+				enchant_dict_remove_from_session (m_dict, utf8word.c_str(), -1);
 			}
 
 			void is_removed (const std::string & utf8word) {
-				enchant_dict_is_removed (m_dict, utf8word.c_str(),
-							     utf8word.size());
+				enchant_dict_is_removed (m_dict, utf8word.c_str(), -1);
 			}
 
 			void store_replacement (const std::string & utf8bad,
 						const std::string & utf8good) {
 				enchant_dict_store_replacement (m_dict,
-								utf8bad.c_str(), utf8bad.size(),
-								utf8good.c_str(), utf8good.size());
+								utf8bad.c_str(), -1,
+								utf8good.c_str(), -1);
 			}
 
 			const std::string & get_lang () const {
@@ -101,6 +101,19 @@ GSList *enchant_get_conf_dirs (void);
  */
 char *enchant_relocate (const char *path);
 
+/**
+ * enchant_is_nfc_quick
+ * @word: A valid UTF-8 string
+ * @len: The length of @word in bytes, or -1 for strlen(@word)
+ *
+ * Returns non-zero if @word can cheaply be seen to be in Unicode
+ * Normalization Form C, so that normalizing it would not change it. This is
+ * the case for ASCII text, and any other text without characters from
+ * U+0300 (the first combining mark) up. If 0 is returned, @word may or may
+ * not be in NFC.
+ */
+int enchant_is_nfc_quick (const char *word, ssize_t len);
+
 /**
  * enchant_provider_dict_new
  * @provider: A provider, or %null.
@@ -157,7 +170,6 @@ struct _EnchantProviderDict
 	void *user_data;
 	EnchantProvider *provider;
 	gchar *language_tag;
-	gchar *error;
 
 	// Implement enchant_dict_check for the given provider dictionary.
 	// This method is mandatory.
@@ -194,6 +206,14 @@ struct _EnchantProviderDict
 	// This method is optional.
 	int (*is_word_character) (struct _EnchantProviderDict * me,
 				  uint32_t uc_in, size_t n);
+
+	// Implement enchant_dict_check_many for the given provider dictionary.
+	// Stores the result of checking each of the @n words in @results, as
+	// for check. The words are valid, non-empty UTF-8.
+	// This method is optional; if it is NULL, check is called for each word.
+	void (*check_many) (struct _EnchantProviderDict * me,
+			    const char *const *words, const size_t *lens,
+			    size_t n, int *results);
 };
 
 typedef struct _EnchantProviderPrivate *EnchantProviderPrivate;
@@ -240,6 +260,22 @@ struct _EnchantProvider {
 	// This method is mandatory.
 	char ** (*list_dicts) (struct _EnchantProvider * me,
 			       size_t * out_n_dicts);
+
+	// Return an array of *out_n_dirs directories in which list_dicts and
+	// dictionary_exists look for dictionaries, each of which is searched
+	// without descending into subdirectories. Enchant caches the results
+	// of list_dicts until the modification time of one of the directories
+	// changes.
+	// This method is optional; if it is NULL, the results are not cached.
+	char ** (*list_dict_dirs) (struct _EnchantProvider * me,
+				   size_t * out_n_dirs);
+
+	// Set to non-zero if calls to one of this provider's dictionaries must
+	// not overlap, for example because the dictionary keeps conversion
+	// buffers. Enchant then makes calls to each dictionary in turn when it
+	// is used from several threads at once; otherwise, they may run in
+	// parallel. The default is 0.
+	int serialize_dict_calls;
 };
 
 #ifdef __cplusplus
@@ -56,6 +56,20 @@ const char *enchant_get_version (void);
  */
 EnchantBroker *enchant_broker_init (void);
 
+/**
+ * enchant_broker_init_lazy
+ *
+ * Returns: A new broker object like enchant_broker_init, except that
+ * provider modules are only loaded when they are needed. A provider module
+ * is taken to be named "enchant_" followed by the provider's name as used
+ * in the ordering file (for example, enchant_hunspell.so), so that
+ * enchant_broker_request_dict only loads the modules for the providers it
+ * tries in turn. Functions that consult all the providers, such as
+ * enchant_broker_describe, enchant_broker_list_dicts and
+ * enchant_broker_dict_exists, load all the remaining modules.
+ */
+EnchantBroker *enchant_broker_init_lazy (void);
+
 /**
  * enchant_broker_free
  * @broker: A non-null #EnchantBroker
@@ -130,6 +144,35 @@ int enchant_broker_dict_exists (EnchantBroker * broker, const char * const tag);
 void enchant_broker_set_ordering (EnchantBroker * broker,
 				  const char * const tag,
 				  const char * const ordering);
+/**
+ * enchant_broker_set_share_dicts
+ * @broker: A non-null #EnchantBroker
+ * @share: Non-zero to share provider dictionaries, or 0 not to
+ *
+ * If @share is non-zero, dictionaries subsequently requested from @broker
+ * for the same language from the same provider share the provider's
+ * dictionary data, which is loaded only once and released when the last
+ * of them is freed. Each #EnchantDict still has its own session and
+ * personal word lists, but words added to a session or personal word list
+ * are not passed on to the provider, so they are accepted by
+ * enchant_dict_check, but are not used by the provider to make
+ * suggestions. Since the dictionaries sharing a provider dictionary may be
+ * used on different threads, calls to a provider dictionary that is not
+ * thread-safe are serialised, as if enchant_dict_set_concurrent had been
+ * called. By default, dictionaries are not shared, unless the
+ * environment variable ENCHANT_SHARE_DICTS is set to a value other than
+ * "0" when @broker is created, which turns sharing on for every broker in
+ * the process.
+ *
+ * Sharing is per broker, because provider dictionaries belong to the
+ * broker's providers. If ENCHANT_SHARE_DICTS is set, providers may also
+ * share their loaded data between dictionaries requested from different
+ * brokers; Hunspell does so for dictionaries whose files have not changed,
+ * serialising the calls that use them, until a word is added to or
+ * removed from the provider dictionary's session.
+ */
+void enchant_broker_set_share_dicts (EnchantBroker * broker, int share);
+
 /**
  * enchant_broker_get_error
  * @broker: A non-null broker
@@ -180,6 +223,55 @@ void enchant_broker_describe (EnchantBroker * broker,
  */
 int enchant_dict_check (EnchantDict * dict, const char *const word, ssize_t len);
 
+/**
+ * enchant_dict_check_many
+ * @dict: A non-null #EnchantDict
+ * @words: A non-null array of @n words you wish to check
+ * @lens: An array of @n lengths of the corresponding words in bytes, any of
+ *     which may be -1 for strlen, or %null to use strlen for every word
+ * @n: The number of words
+ * @results: A non-null array of @n elements in which to store the results
+ *
+ * Checks each of @words as enchant_dict_check would, storing the result for
+ * words[i] in results[i]. This is faster than calling enchant_dict_check
+ * for each word, as the personal word lists are only reread once, and the
+ * provider may check the words in a single call.
+ */
+void enchant_dict_check_many (EnchantDict * dict, const char *const *words,
+			      const ssize_t *lens, size_t n, int *results);
+
+/**
+ * enchant_dict_set_check_cache_size
+ * @dict: A non-null #EnchantDict
+ * @size: The maximum number of words whose results are cached, or 0 to
+ *     disable the cache
+ *
+ * Enables a cache of the results of checking words with the provider, used
+ * by enchant_dict_check and enchant_dict_check_many. Words that are
+ * resolved by the session or personal word lists are not cached. When the
+ * cache is full, words that have not been used recently are evicted. The
+ * cache is cleared whenever words are added to or removed from the
+ * session, including by enchant_dict_add, enchant_dict_remove, and when
+ * the personal word lists are reread. By default, there is no cache.
+ *
+ * For a dictionary with multiple tags, each dictionary gets its own cache
+ * of the given size.
+ */
+void enchant_dict_set_check_cache_size (EnchantDict * dict, size_t size);
+
+/**
+ * enchant_dict_get_check_cache_stats
+ * @dict: A non-null #EnchantDict
+ * @hits: The location in which to store the number of cache hits, or %null
+ * @misses: The location in which to store the number of cache misses, or
+ *     %null
+ *
+ * Returns the cache statistics since enchant_dict_set_check_cache_size was
+ * last called; both are 0 if there is no cache.
+ */
+void enchant_dict_get_check_cache_stats (EnchantDict * dict,
+					 size_t * hits, size_t * misses);
+
 /**
  * enchant_dict_suggest
  * @dict: A non-null #EnchantDict
@@ -194,6 +286,74 @@ int enchant_dict_check (EnchantDict * dict, const char *const word, ssize_t len)
 char **enchant_dict_suggest (EnchantDict * dict, const char *const word,
 			     ssize_t len, size_t * out_n_suggs);
 
+/**
+ * enchant_dict_suggest_many
+ * @dict: A non-null #EnchantDict
+ * @words: A non-null array of @n words you wish to find suggestions for
+ * @lens: An array of @n lengths of the corresponding words in bytes, any of
+ *     which may be -1 for strlen, or %null to use strlen for every word
+ * @n: The number of words
+ * @out_n_suggs: An array of @n elements in which to store the number of
+ *     suggestions returned for each word, or %null
+ *
+ * Finds suggestions for each of @words as enchant_dict_suggest would.
+ *
+ * Returns: An array of @n lists, where element i is the %null terminated
+ * list of suggestions for words[i], or %null if an error occurred for that
+ * word; or %null if any of the pre-conditions is not met. The lists and
+ * their strings are stored in a single block of memory, which must be
+ * released with enchant_dict_free_string_lists. If @n is 0, the result is
+ * an empty array, which is not %null.
+ */
+char ***enchant_dict_suggest_many (EnchantDict * dict,
+				   const char *const *words, const ssize_t *lens,
+				   size_t n, size_t * out_n_suggs);
+
+/**
+ * enchant_dict_set_suggest_cache_size
+ * @dict: A non-null #EnchantDict
+ * @max_size: The approximate maximum number of bytes of memory used by the
+ *     cache, or 0 to disable the cache
+ *
+ * Enables a cache of the suggestions returned by enchant_dict_suggest and
+ * enchant_dict_suggest_many. When the cache is full, words that have not
+ * been used recently are evicted. Cached suggestions are not reused after
+ * words are added to or removed from the session, or the personal or
+ * exclude word lists change. By default, there is no cache.
+ *
+ * For a dictionary with multiple tags, each dictionary gets its own cache
+ * of the given size.
+ */
+void enchant_dict_set_suggest_cache_size (EnchantDict * dict, size_t max_size);
+
+/**
+ * enchant_dict_get_suggest_cache_stats
+ * @dict: A non-null #EnchantDict
+ * @hits: The location in which to store the number of cache hits, or %null
+ * @misses: The location in which to store the number of cache misses, or
+ *     %null
+ *
+ * Returns the cache statistics since enchant_dict_set_suggest_cache_size
+ * was last called; both are 0 if there is no cache.
+ */
+void enchant_dict_get_suggest_cache_stats (EnchantDict * dict,
+					   size_t * hits, size_t * misses);
+
+/**
+ * enchant_dict_set_max_suggestions
+ * @dict: A non-null #EnchantDict
+ * @max_suggestions: The maximum number of suggestions to return for a word,
+ *     or 0 for no limit
+ *
+ * Limits the number of suggestions returned by enchant_dict_suggest and
+ * enchant_dict_suggest_many. By default, there is no limit.
+ *
+ * For a dictionary with multiple tags, the suggestions of the dictionaries
+ * are merged by taking the best remaining suggestion of each dictionary in
+ * turn, and duplicates are removed; merging stops when the limit is reached.
+ */
+void enchant_dict_set_max_suggestions (EnchantDict * dict, size_t max_suggestions);
+
 /**
  * enchant_dict_add
  * @dict: A non-null #EnchantDict
@@ -205,6 +365,22 @@ char **enchant_dict_suggest (EnchantDict * dict, const char *const word,
  */
 void enchant_dict_add (EnchantDict * dict, const char *const word, ssize_t len);
 
+/**
+ * enchant_dict_add_many
+ * @dict: A non-null #EnchantDict
+ * @words: A non-null array of @n words you wish to add to your personal
+ *     dictionary
+ * @lens: An array of @n lengths of the corresponding words in bytes, any of
+ *     which may be -1 for strlen, or %null to use strlen for every word
+ * @n: The number of words
+ *
+ * Adds each of @words as enchant_dict_add would. This is faster than calling
+ * enchant_dict_add for each word, as the personal and exclude dictionaries
+ * are each written only once. Null, empty and invalid words are ignored.
+ */
+void enchant_dict_add_many (EnchantDict * dict, const char *const *words,
+			    const ssize_t *lens, size_t n);
+
 /**
  * enchant_dict_add_to_session
  * @dict: A non-null #EnchantDict
@@ -224,6 +400,23 @@ void enchant_dict_add_to_session (EnchantDict * dict, const char *const word, ss
  */
 void enchant_dict_remove (EnchantDict * dict, const char *const word, ssize_t len);
 
+/**
+ * enchant_dict_remove_many
+ * @dict: A non-null #EnchantDict
+ * @words: A non-null array of @n words you wish to add to your exclude
+ *     dictionary and remove from the personal dictionary
+ * @lens: An array of @n lengths of the corresponding words in bytes, any of
+ *     which may be -1 for strlen, or %null to use strlen for every word
+ * @n: The number of words
+ *
+ * Removes each of @words as enchant_dict_remove would. This is faster than
+ * calling enchant_dict_remove for each word, as the personal and exclude
+ * dictionaries are each written only once. Null, empty and invalid words are
+ * ignored.
+ */
+void enchant_dict_remove_many (EnchantDict * dict, const char *const *words,
+			       const ssize_t *lens, size_t n);
+
 /**
  * enchant_dict_remove_from_session
  * @dict: A non-null #EnchantDict
@@ -278,14 +471,24 @@ void enchant_dict_store_replacement (EnchantDict * dict,
  */
 void enchant_dict_free_string_list (EnchantDict * dict, char **string_list);
 
+/**
+ * enchant_dict_free_string_lists
+ * @dict: A non-null #EnchantDict
+ * @string_lists: A non-null array of string lists returned from
+ *     enchant_dict_suggest_many
+ *
+ * Releases the string lists.
+ */
+void enchant_dict_free_string_lists (EnchantDict * dict, char ***string_lists);
+
 /**
  * enchant_dict_get_error
  * @dict: A non-null #EnchantDict
  *
- * Returns: a possibly-invalid UTF-8 string describing the last exception,
- * or %null.
+ * Returns: a possibly-invalid UTF-8 string describing the last exception
+ * raised by an operation on @dict in the calling thread, or %null.
  * WARNING: error is transient. It will likely be cleared as soon as
- * the next dictionary operation is called.
+ * the next dictionary operation is called in the same thread.
  */
 const char *enchant_dict_get_error (EnchantDict * dict);
 
@@ -349,6 +552,96 @@ typedef void (*EnchantDictDescribeFn) (const char * const lang_tag,
 				       const char * const provider_file,
 				       void * user_data);
 
+/**
+ * enchant_dict_set_concurrent
+ * @dict: A non-null #EnchantDict
+ * @concurrent: Non-zero to allow concurrent use, or 0 not to
+ *
+ * By default, an #EnchantDict must not be used by more than one thread at
+ * a time. If @concurrent is non-zero, any of the dictionary functions may
+ * be called on @dict from several threads at once. Checks, suggestions and
+ * lookups of added and removed words proceed in parallel, as do calls to
+ * the underlying provider dictionary, unless its provider requires them to
+ * be made one at a time. Adding or
+ * removing words, and rereading the personal word lists after they have
+ * been changed by another program, excludes all other use of @dict while
+ * it takes place.
+ *
+ * This function must itself be called before @dict is shared between
+ * threads. The #EnchantBroker is not made thread-safe, so requesting and
+ * freeing dictionaries must still be done by one thread at a time. Errors
+ * are reported per thread; see enchant_dict_get_error.
+ */
+void enchant_dict_set_concurrent (EnchantDict * dict, int concurrent);
+
+/**
+ * enchant_dict_set_parallel
+ * @dict: A non-null #EnchantDict
+ * @parallel: Non-zero to call the member dictionaries in parallel, or 0 not to
+ *
+ * If @dict was requested with a tag naming several dictionaries separated
+ * by commas, and @parallel is non-zero, checks and suggestions are passed to
+ * the member dictionaries concurrently on a pool of worker threads shared by
+ * all such dictionaries. Suggestions are returned in the same order as when
+ * the members are called one after another. A check returns as soon as any
+ * member finds the word; members that have not yet started are skipped.
+ *
+ * Enabling parallel calls makes the member dictionaries concurrent; see
+ * enchant_dict_set_concurrent. For other dictionaries, this function has no
+ * effect.
+ */
+void enchant_dict_set_parallel (EnchantDict * dict, int parallel);
+
+/**
+ * enchant_dict_set_pwl_refresh_interval
+ * @dict: A non-null #EnchantDict
+ * @interval_ms: The minimum interval in milliseconds between checks
+ *
+ * By default, the personal and exclude word lists are checked for changes
+ * made by other programs every time they are consulted, which involves a
+ * system call per word list for each word checked. This function sets a
+ * minimum interval between such checks, so that changes made by other
+ * programs may take up to @interval_ms to be noticed. Changes made through
+ * @dict are always seen immediately. An interval of 0 restores the
+ * default.
+ */
+void enchant_dict_set_pwl_refresh_interval (EnchantDict * dict, unsigned int interval_ms);
+
+/**
+ * enchant_dict_set_pwl_index
+ * @dict: A non-null #EnchantDict
+ * @use_index: Non-zero to use word list indexes, or 0 not to
+ *
+ * By default, the personal and exclude word lists are read into memory
+ * whenever they change, and the words of the personal word list are added
+ * to the session. If @use_index is non-zero, a sorted index of each word
+ * list is instead kept in a file beside it, with the suffix `.idx`, and
+ * mapped into memory, so that large word lists can be consulted without
+ * reading them in. The index is remade when the word list changes. In this
+ * mode, the words of the personal word list are not passed to the
+ * provider, so they may not be offered as suggestions, and any already
+ * passed to it are taken back.
+ */
+void enchant_dict_set_pwl_index (EnchantDict * dict, int use_index);
+
+/**
+ * enchant_dict_set_lazy_pwl
+ * @dict: A non-null #EnchantDict
+ * @lazy_pwl: Non-zero to pass personal words to the provider only when
+ *     needed, or 0 to pass them as they are read
+ *
+ * By default, whenever the personal word list is read, each of its words
+ * is added to the session, and so passed to the provider, which can make
+ * opening a dictionary with a large personal word list slow. If @lazy_pwl
+ * is non-zero, the personal word list is instead consulted directly when
+ * checking words, and its words are passed to the provider together only
+ * when suggestions are next requested, so that they can be offered as
+ * suggestions. Changing the mode after @dict has been used takes back
+ * from the provider, or gives it, whatever words are needed to bring it up
+ * to date with the personal word list.
+ */
+void enchant_dict_set_lazy_pwl (EnchantDict * dict, int lazy_pwl);
+
 /**
  * enchant_dict_describe
  * @broker: A non-null #EnchantDict
@@ -41,12 +41,17 @@ public delegate void DictRemoveFromSession(EnchantProviderDict me, string word,
 public delegate unowned string DictGetExtraWordCharacters(EnchantProviderDict me);
 [CCode (has_target = false)]
 public delegate int DictIsWordCharacter(EnchantProviderDict me, uint32 uc_in, real_size_t n);
+[CCode (has_target = false)]
+public delegate void DictCheckMany(EnchantProviderDict me,
+								  [CCode (array_length = false)] string[] words,
+								  [CCode (array_length = false)] real_size_t[] lens,
+								  real_size_t n,
+								  [CCode (array_length = false)] int[] results);
 
 public class EnchantProviderDict {
 	public void *user_data;
 	public EnchantProvider? provider;
 	public string language_tag;
-	public string error;
 
 	// Provider methods
 	public DictCheck check_method;
@@ -55,20 +60,79 @@ public class EnchantProviderDict {
 	public DictRemoveFromSession? remove_from_session_method;
 	public DictGetExtraWordCharacters? get_extra_word_characters_method;
 	public DictIsWordCharacter? is_word_character_method;
+	public DictCheckMany? check_many_method;
+
+	/* Each thread's last error for each dictionary, in a table private to
+	   the thread that is freed when it exits, keyed by dictionary id.  Ids
+	   are not reused, so a thread never sees the error of a dictionary
+	   that has since been freed. */
+	static Private thread_errors = new Private(free_thread_errors);
+	static int next_id = 1;
+	int id;
+
+	/* Calls to the provider methods are serialised if the provider asks
+	   for it and the dictionary may be used by several threads at once;
+	   see EnchantDict.set_concurrent. */
+	bool serialize_calls = false;
+	Mutex call_mutex;
 
 	public EnchantProviderDict(EnchantProvider? provider, string tag) {
 		this.provider = provider;
 		this.language_tag = tag;
-		this.error = null;
+		this.id = AtomicInt.add(ref next_id, 1);
 	}
 
 	~EnchantProviderDict() {
+		this.clear_thread_error();
 		if (this.provider != null)
 			this.provider.dispose_dict(this.provider, this);
 	}
 
+	static void free_thread_errors(void *errors) {
+		delete (HashTable<void *, string> *)errors;
+	}
+
+	/* The calling thread's error table, which is made if create is true
+	   and it does not exist. */
+	static unowned HashTable<void *, string>? get_thread_errors(bool create) {
+		var errors = (HashTable<void *, string> *)thread_errors.get();
+		if (errors == null && create) {
+			var table = new HashTable<void *, string>(direct_hash, direct_equal);
+			errors = (owned)table;
+			thread_errors.set(errors);
+		}
+		return (HashTable<void *, string>?)errors;
+	}
+
 	public void set_error(string err) {
 		debug("enchant_provider_dict_set_error: %s", err);
-		this.error = err;
+		get_thread_errors(true).insert((void *)this.id, err);
+	}
+
+	/* The string remains valid until the calling thread sets or clears
+	   its error. */
+	internal unowned string? get_thread_error() {
+		unowned HashTable<void *, string>? errors = get_thread_errors(false);
+		return errors != null ? errors.lookup((void *)this.id) : null;
+	}
+
+	internal void clear_thread_error() {
+		unowned HashTable<void *, string>? errors = get_thread_errors(false);
+		if (errors != null)
+			errors.remove((void *)this.id);
+	}
+
+	internal void set_serialize_calls(bool serialize) {
+		this.serialize_calls = serialize;
+	}
+
+	internal void begin_call() {
+		if (this.serialize_calls)
+			this.call_mutex.lock();
+	}
+
+	internal void end_call() {
+		if (this.serialize_calls)
+			this.call_mutex.unlock();
 	}
 }
@@ -74,6 +74,8 @@ public delegate unowned string ProviderIdentify(EnchantProvider me);
 public delegate unowned string ProviderDescribe(EnchantProvider me);
 [CCode (has_target = false, array_length_type = "size_t")]
 public delegate string[] ProviderListDicts(EnchantProvider me);
+[CCode (has_target = false, array_length_type = "size_t")]
+public delegate string[] ProviderListDictDirs(EnchantProvider me);
 
 public class EnchantProvider {
 	public void *user_data;
@@ -86,6 +88,8 @@ public class EnchantProvider {
 	public ProviderIdentify identify;
 	public ProviderDescribe describe;
 	public ProviderListDicts list_dicts;
+	public ProviderListDictDirs? list_dict_dirs;
+	public bool serialize_dict_calls;
 
 	~EnchantProvider() {
 		var module = (owned)this.module;
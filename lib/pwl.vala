@@ -40,6 +40,14 @@ using Gnu;
 
 const unichar BOM = 0xfeff;
 
+/* In a file whose first line is TOMBSTONE_HEADER, a line starting with
+   TOMBSTONE records the removal of the word following it from the lines
+   above.  In other files, such lines are ordinary comments, so that
+   comments written by people or other programs are never taken for
+   removals. */
+const string TOMBSTONE_HEADER = "#!enchant-pwl tombstones";
+const string TOMBSTONE = "#-";
+
 void lock_file(FileStream f) {
 	flock(f.fileno(), FlockOperation.EX);
 }
@@ -121,141 +129,472 @@ bool is_title_case(string word) {
 	return true;
 }
 
+/* The header of a word list index file.  The header is followed by
+   n_words offsets into the strings that follow them, then the
+   nul-terminated words themselves, normalized and in strcmp order. */
+struct EnchantPWLIndexHeader {
+	uint8 magic[8];
+	/* The stats of the word list that the index was made from. */
+	int64 mtime;
+	int64 mtime_ns;
+	int64 size;
+	uint64 ino;
+	uint64 n_words;
+}
+
+const string PWL_INDEX_MAGIC = "EPWLIDX2";
+
+void append_raw(ByteArray buf, void *data, size_t len) {
+	unowned uint8[] bytes = (uint8[])data;
+	bytes.length = (int)len;
+	buf.append(bytes);
+}
+
+/* A sorted index of the words in a word list, kept in a file beside it and
+   mapped into memory, so that a large list can be searched without
+   reading it all in. */
+class EnchantPWLIndex {
+	MappedFile file;
+	uint64 n_words;
+	uint64 *offsets;
+	char *strings;
+	size_t strings_len;
+
+	/* Map the index file, if it is valid and was made from a word list
+	   with the given stats, which should be taken while the word list is
+	   locked. */
+	public static EnchantPWLIndex? open(string index_filename, Posix.Stat stats) {
+		var index = new EnchantPWLIndex();
+		try {
+			index.file = new MappedFile(index_filename, false);
+		} catch (FileError e) {
+			return null;
+		}
+
+		size_t len = index.file.get_length();
+		char *data = index.file.get_contents();
+		if (len < sizeof(EnchantPWLIndexHeader))
+			return null;
+		EnchantPWLIndexHeader header = {};
+		Memory.copy(&header, data, sizeof(EnchantPWLIndexHeader));
+		if (Memory.cmp(header.magic, (void *)PWL_INDEX_MAGIC, header.magic.length) != 0 ||
+			header.mtime != (int64)stats.st_mtime ||
+			header.mtime_ns != (int64)get_stat_mtime_ns(stats) ||
+			header.size != (int64)stats.st_size || header.ino != (uint64)stats.st_ino)
+			return null;
+
+		/* Check the word count before using it, so that a corrupt count
+		   cannot overflow. */
+		if (header.n_words > (len - sizeof(EnchantPWLIndexHeader)) / sizeof(uint64))
+			return null;
+		size_t strings_start = sizeof(EnchantPWLIndexHeader) + (size_t)header.n_words * sizeof(uint64);
+		if (len > strings_start && data[len - 1] != '\0')
+			return null;
+
+		index.n_words = header.n_words;
+		index.offsets = (uint64 *)(data + sizeof(EnchantPWLIndexHeader));
+		index.strings = data + strings_start;
+		index.strings_len = len - strings_start;
+		return index;
+	}
+
+	/* Write an index of the keys of words, and map it. */
+	public static EnchantPWLIndex? create(string index_filename, Posix.Stat stats, HashTable<string, string> words) {
+		var keys = words.get_keys();
+		keys.sort(strcmp);
+
+		EnchantPWLIndexHeader header = {};
+		Memory.copy(header.magic, (void *)PWL_INDEX_MAGIC, header.magic.length);
+		header.mtime = (int64)stats.st_mtime;
+		header.mtime_ns = (int64)get_stat_mtime_ns(stats);
+		header.size = (int64)stats.st_size;
+		header.ino = (uint64)stats.st_ino;
+		header.n_words = keys.length();
+
+		var buf = new ByteArray();
+		append_raw(buf, &header, sizeof(EnchantPWLIndexHeader));
+		uint64 offset = 0;
+		foreach (unowned string word in keys) {
+			append_raw(buf, &offset, sizeof(uint64));
+			offset += word.length + 1;
+		}
+		foreach (unowned string word in keys)
+			append_raw(buf, (void *)word, word.length + 1);
+
+		try {
+			FileUtils.set_data(index_filename, buf.data);
+		} catch (FileError e) {
+			return null;
+		}
+		return EnchantPWLIndex.open(index_filename, stats);
+	}
+
+	public bool contains(string word) {
+		uint64 lo = 0, hi = this.n_words;
+		while (lo < hi) {
+			uint64 mid = lo + (hi - lo) / 2;
+			uint64 offset;
+			Memory.copy(&offset, &this.offsets[mid], sizeof(uint64));
+			if (offset >= this.strings_len)
+				return false; /* corrupt index */
+			int cmp = strcmp((string)(this.strings + offset), word);
+			if (cmp == 0)
+				return true;
+			if (cmp < 0)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return false;
+	}
+}
+
 public class EnchantPWL {
 	private string? filename;
 	private bool exclude = false;
 	private time_t file_changed = 0;
+	/* The length, inode and last few bytes of the part of the file that has
+	   been read, used to notice when it has only been appended to. */
+	private int64 file_offset = 0;
+	private uint64 file_ino = 0;
+	private uint8[] file_tail = {};
+	private int64 last_refresh = 0;
+	/* Minimum time between checks of the file for changes, in
+	   microseconds. */
+	public int64 refresh_interval = 0;
 	private HashTable<string, string> words = new HashTable<string, string>(str_hash, str_equal);
+	/* The number of title-case words in words with each lower-case form,
+	   so that all-caps words can be looked up with one probe.  Lower-case
+	   words are their own lower-case form, so they need no entry. */
+	private HashTable<string, int> folded = new HashTable<string, int>(str_hash, str_equal);
+	/* If use_index is set, the words in the file are looked up in index,
+	   and words only holds those added since it was made. */
+	private bool use_index = false;
+	private EnchantPWLIndex? index = null;
+	/* Words removed since the index was made. */
+	private GenericSet<string> removed = new GenericSet<string>(str_hash, str_equal);
+	/* Whether the file starts with TOMBSTONE_HEADER. */
+	private bool has_tombstones = false;
+	/* The number of removals recorded in the file. */
+	private uint n_tombstones = 0;
 
 	public EnchantPWL(string? filename, bool exclude = false) {
 		this.filename = filename;
 		this.exclude = exclude;
 	}
 
+	/* Use an index file beside the word list rather than reading all the
+	   words into memory; the file is reread on the next refresh.  The
+	   words read so far are dropped, so that the reread does not take back
+	   from the provider words that were never passed to it. */
+	public void set_use_index(bool use_index) {
+		this.use_index = use_index;
+		this.index = null;
+		this.clear_table();
+		this.removed.remove_all();
+		this.file_changed = 0;
+		this.file_offset = 0;
+		this.last_refresh = 0;
+	}
+
+	bool has_word(string normalized_word) {
+		return this.words.contains(normalized_word) ||
+			(this.index != null && !this.removed.contains(normalized_word) &&
+			 this.index.contains(normalized_word));
+	}
+
+	/* The normalized lower-case form of a word. */
+	static string fold(string word) {
+		string lower_case_word = word.down();
+		string? normalized_copy;
+		nfc_string(lower_case_word, out normalized_copy);
+		if (normalized_copy != null)
+			return (owned)normalized_copy;
+		return (owned)lower_case_word;
+	}
+
+	/* The key in folded for a normalized word, or null if it is not in
+	   title case.  Other words are not folded, to save the copy. */
+	static string? fold_title_case(string normalized_word) {
+		if (!is_title_case(normalized_word))
+			return null;
+		string title_case_word = utf8_strtitle(normalized_word);
+		string? normalized_copy;
+		if (nfc_string(title_case_word, out normalized_copy) != normalized_word)
+			return null;
+		return fold(normalized_word);
+	}
+
+	void clear_table() {
+		this.words.remove_all();
+		this.folded.remove_all();
+	}
+
+	void insert_word(string normalized_word, string word) {
+		this.words.insert(normalized_word, word);
+		string? folded_word = fold_title_case(normalized_word);
+		if (folded_word != null)
+			this.folded.insert(folded_word, this.folded.lookup(folded_word) + 1);
+	}
+
+	void remove_word(string normalized_word) {
+		if (!this.words.remove(normalized_word))
+			return;
+		string? folded_word = fold_title_case(normalized_word);
+		if (folded_word == null)
+			return;
+		int n_title_case = this.folded.lookup(folded_word) - 1;
+		if (n_title_case > 0)
+			this.folded.insert(folded_word, n_title_case);
+		else
+			this.folded.remove(folded_word);
+	}
+
+	/* Whether the words read from the file are passed to the session's
+	   provider when the session is not in lazy mode. */
+	public bool passes_words_to_session() {
+		return !this.exclude && !this.use_index;
+	}
+
+	/* The normalized words read from the file, other than those in the
+	   index. */
+	public GenericSet<string> get_words() {
+		var words = new GenericSet<string>(str_hash, str_equal);
+		foreach (unowned string word in this.words.get_keys())
+			words.add(word);
+		return words;
+	}
+
+	/* The approximate number of words in the list. */
+	uint n_words() {
+		uint n = this.words.size();
+		if (this.index != null)
+			n += this.index.n_words - uint.min(this.removed.length, this.index.n_words);
+		return n;
+	}
+
 	void add_to_table(string word) {
-		string normalized_word = word.normalize();
+		string? normalized_copy;
+		unowned string normalized_word = nfc_string(word, out normalized_copy);
+		this.removed.remove(normalized_word);
 		if (!this.words.contains(normalized_word))
-			this.words.insert(normalized_word, word);
+			this.insert_word(normalized_word, word);
+	}
+
+	/* Remove a word from the table, returning its normalized form. */
+	string remove_from_table(string word) {
+		string? normalized_copy;
+		string normalized_word = nfc_string(word, out normalized_copy);
+		this.remove_word(normalized_word);
+		if (this.index != null)
+			this.removed.add(normalized_word);
+		return normalized_word;
+	}
+
+	/* Append lines to the file, each with the given prefix, in a single
+	   write.  The file must be open for writing and locked. */
+	static void append_lines(FileStream f, string[] lines, string prefix = "") {
+		/* Since this method does not signal I/O errors, only use
+		   return values to avoid doing things that seem futile. */
+		var buf = new StringBuilder();
+
+		/* Add a newline if the file doesn't end with one. */
+		if (f.seek(-1, FileSeek.END) == 0) {
+			int c = f.getc();
+			f.seek(0, FileSeek.CUR); /* ISO C requires positioning between read and write. */
+			if (c != '\n')
+				buf.append_c('\n');
+		} else
+			f.seek(0, FileSeek.END);
+
+		foreach (unowned string line in lines) {
+			buf.append(prefix);
+			buf.append(line);
+			buf.append_c('\n');
+		}
+		f.puts(buf.str);
 	}
 
 	public void add(EnchantDict session, string? word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return;
 
-		string word = buf_to_utf8_string(word_buf, len);
+		string? word_copy;
+		unowned string? word = buf_to_utf8_string(word_buf, len, out word_copy);
 		if (word == null || word.length == 0)
 			return;
 
-		this.refresh_from_file(session);
-		this.add_to_table(word);
-
-		if (this.filename != null) {
-			FileStream? f = FileStream.open(this.filename, "a+");
-			if (f != null) {
-				/* Since this method does not signal I/O errors, only use
-				   return values to avoid doing things that seem futile. */
-				lock_file(f);
-				Posix.Stat stats;
-				if (Posix.stat(this.filename, out stats) == 0)
-					this.file_changed = stats.st_mtime;
-
-				/* Add a newline if the file doesn't end with one. */
-				if (f.seek(-1, FileSeek.END) == 0) {
-					int c = f.getc();
-					f.seek(0, FileSeek.CUR); /* ISO C requires positioning between read and write. */
-					if (c != '\n')
-						f.putc('\n');
-				}
-
-				if (f.puts(word) != FileStream.EOF)
-					f.putc('\n');
-				unlock_file(f);
-			}
+		this.add_many(session, {word});
+	}
+
+	/* Add valid, non-empty words, writing them to the file together.  The
+	   file is reread, if need be, while it is locked for writing. */
+	public void add_many(EnchantDict session, string[] words) {
+		if (words.length == 0)
+			return;
+
+		FileStream? f = null;
+		if (this.filename != null)
+			f = FileStream.open(this.filename, "a+");
+		if (f == null) {
+			this.refresh_from_file(session, true);
+			foreach (unowned string word in words)
+				this.add_to_table(word);
+			return;
 		}
+
+		lock_file(f);
+		this.refresh_locked(session, f);
+		foreach (unowned string word in words)
+			this.add_to_table(word);
+		append_lines(f, words);
+		this.mark_written(f);
+		unlock_file(f);
 	}
 
+	/* Removals are appended to the file as tombstones, and the file is
+	   compacted once there are more of them than words.  A file without
+	   TOMBSTONE_HEADER is given one first. */
 	public void remove(EnchantDict session, string word_buf, real_ssize_t len) {
 		if (word_buf == null)
 			return;
 
-		string word = buf_to_utf8_string(word_buf, len);
+		string? word_copy;
+		unowned string? word = buf_to_utf8_string(word_buf, len, out word_copy);
 		if (word == null || word.length == 0)
 			return;
 
-		this.refresh_from_file(session);
-		this.words.remove(word.normalize());
+		this.remove_many(session, {word});
+	}
 
-		if (this.filename != null) {
-			string contents;
-			size_t length;
-			try {
-				FileUtils.get_contents(this.filename, out contents, out length);
-			} catch (GLib.FileError e) {
-				return;
-			}
+	/* Remove valid, non-empty words, writing their tombstones to the file
+	   together.  As in add_many, the file is reread while it is locked
+	   for writing; a file that does not exist is not created. */
+	public void remove_many(EnchantDict session, string[] words) {
+		if (words.length == 0)
+			return;
 
-			var f = FileStream.open(this.filename, "wb"); /* binary because get_contents reads binary */
-			if (f != null) {
-				lock_file(f);
-				long filestart = 0;
-
-				// Copy BOM if present.
-				if (BOM == contents.get_char(filestart)) {
-					contents = contents.next_char();
-					f.puts(BOM.to_string());
-				}
-
-				for (int start_index = 0;;) {
-					// find word
-					var word_pos = contents.index_of(word, start_index);
-					if (word_pos == -1) {
-						f.puts(contents.substring(start_index));
-						break;
-					} else {
-						if ((word_pos == 0 || contents[word_pos - 1] == '\n' || contents[word_pos - 1] == '\r') &&
-							(word_pos + word.length == contents.length || contents[word_pos + word.length] == '\n' || contents[word_pos + word.length] == '\r')) {
-							f.puts(contents.substring(start_index, word_pos - start_index));
-							start_index = word_pos + word.length;
-							while (contents[start_index] == '\n' || contents[start_index] == '\r')
-								++start_index;
-						} else {
-							f.puts(contents.substring(start_index, word_pos - start_index + 1));
-							start_index = word_pos + 1;
-						}
-					}
-				}
+		FileStream? f = null;
+		if (this.filename != null)
+			f = FileStream.open(this.filename, "r+");
+		if (f == null)
+			this.refresh_from_file(session, true);
+		else {
+			lock_file(f);
+			this.refresh_locked(session, f);
+		}
 
-				Posix.Stat stats;
-				if (Posix.stat(this.filename, out stats) == 0)
-					this.file_changed = stats.st_mtime;
+		string[] removed_words = {};
+		foreach (unowned string word in words) {
+			string? normalized_copy;
+			if (this.has_word(nfc_string(word, out normalized_copy))) {
+				this.remove_from_table(word);
+				removed_words += word;
+			}
+		}
 
-				unlock_file(f);
+		if (f != null) {
+			if (removed_words.length > 0) {
+				if (!starts_with_tombstone_header(f))
+					this.compact(f, true);
+				append_lines(f, removed_words, TOMBSTONE);
+				this.has_tombstones = true;
+				this.n_tombstones += (uint)removed_words.length;
+				if (this.n_tombstones > this.n_words())
+					this.compact(f, false);
+				this.mark_written(f);
 			}
+			unlock_file(f);
 		}
 	}
 
-	public int check(EnchantDict session, string word_buf, real_ssize_t len) {
-		if (word_buf == null)
-			return 0;
+	/* Whether the file starts with TOMBSTONE_HEADER.  The file must be
+	   locked. */
+	static bool starts_with_tombstone_header(FileStream f) {
+		f.rewind();
+		string? line = f.read_line();
+		if (line == null)
+			return false;
+		if (BOM == line.get_char())
+			line = line.next_char();
+		return line.chomp() == TOMBSTONE_HEADER;
+	}
 
-		string word = buf_to_utf8_string(word_buf, len);
-		if (word == null || word.length == 0)
-			return 0;
+	/* Rewrite the file without the tombstones and the words they remove,
+	   starting it with TOMBSTONE_HEADER if header is true.  The file must
+	   be open for reading and writing, and locked. */
+	void compact(FileStream f, bool header) {
+		f.rewind();
+		var lines = new GenericArray<string>();
+		string? line;
+		while ((line = f.read_line()) != null)
+			lines.add(line);
+
+		bool has_bom = lines.length > 0 && BOM == lines[0].get_char();
+		if (has_bom)
+			lines[0] = lines[0].next_char();
+		bool had_header = lines.length > 0 && lines[0].chomp() == TOMBSTONE_HEADER;
+
+		/* Work backwards, so that a word added again after being removed
+		   is kept. */
+		var tombstoned = new GenericSet<string>(str_hash, str_equal);
+		var keep = new bool[lines.length];
+		for (int i = lines.length - 1; i >= (had_header ? 1 : 0); i--) {
+			string text = lines[i].chomp();
+			string? normalized_copy;
+			if (had_header && text.has_prefix(TOMBSTONE) && text.validate())
+				tombstoned.add(nfc_string(text.offset(TOMBSTONE.length), out normalized_copy));
+			else
+				keep[i] = text[0] == '\0' || text[0] == '#' || !text.validate() ||
+					!tombstoned.contains(nfc_string(text, out normalized_copy));
+		}
 
-		this.refresh_from_file(session);
+		if (ftruncate(f.fileno(), 0) != 0)
+			return;
+		f.seek(0, FileSeek.SET);
+		if (has_bom)
+			f.puts(BOM.to_string());
+		if (header) {
+			f.puts(TOMBSTONE_HEADER);
+			f.putc('\n');
+		}
+		for (int i = 0; i < lines.length; i++)
+			if (keep[i]) {
+				/* Keep comments from being taken for tombstones. */
+				if (header && !had_header && lines[i].has_prefix(TOMBSTONE))
+					f.putc('#');
+				f.puts(lines[i]);
+				f.putc('\n');
+			}
+		this.has_tombstones = header;
+		this.n_tombstones = 0;
+		this.file_offset = 0;
+	}
 
-		if (this.words.contains(word.normalize()))
+	/* Returns 0 if the word is in the list, in any of its allowed casings,
+	   and 1 otherwise.  The file is not reread; the caller must call
+	   refresh_from_file first. */
+	public int lookup(string word) {
+		if (word.length == 0)
+			return 0;
+		if (this.words.size() == 0 && this.index == null)
+			return 1; /* avoid normalizing the word */
+
+		string? normalized_copy;
+		if (this.has_word(nfc_string(word, out normalized_copy)))
 			return 0;
 
 		bool all_caps = false;
 		if (is_title_case(word) || (all_caps = is_all_caps(word))) {
-			string lower_case_word = word.down();
-			if (this.words.contains(lower_case_word.normalize()))
+			string folded_word = fold(word);
+			if (this.has_word(folded_word) ||
+				(all_caps && this.folded.lookup(folded_word) > 0))
 				return 0;
 
-			if (all_caps) {
+			/* The index only holds words as they are in the file. */
+			if (this.index != null && all_caps) {
 				string title_case_word = utf8_strtitle(word);
-				if (this.words.contains(title_case_word.normalize()))
+				if (this.has_word(nfc_string(title_case_word, out normalized_copy)))
 					return 0;
 			}
 		}
@@ -263,30 +602,164 @@ public class EnchantPWL {
 		return 1; /* not found */
 	}
 
-	void refresh_from_file(EnchantDict session) {
+	/* Returns true if refresh_from_file would reread the file, or check it
+	   for changes after refresh_interval has elapsed. */
+	public bool is_stale() {
 		if (this.filename == null)
+			return false;
+		if (this.refresh_interval > 0)
+			return get_monotonic_time() - this.last_refresh >= this.refresh_interval;
+
+		Posix.Stat stats;
+		return Posix.stat(this.filename, out stats) == 0 && this.file_changed != stats.st_mtime;
+	}
+
+	static uint8[]? read_bytes(FileStream f, int64 start, size_t len) {
+		if (f.seek((long)start, FileSeek.SET) != 0)
+			return null;
+		var buf = new uint8[len];
+		if (f.read(buf) != len)
+			return null;
+		return buf;
+	}
+
+	/* Record that f has been read up to offset. */
+	void mark_read(FileStream f, Posix.Stat stats, int64 offset) {
+		size_t tail_length = (size_t)int64.min(offset, 64);
+		uint8[]? tail = read_bytes(f, offset - (int64)tail_length, tail_length);
+		this.file_offset = tail != null ? offset : 0;
+		this.file_ino = (uint64)stats.st_ino;
+		this.file_tail = tail != null ? (owned)tail : new uint8[0];
+	}
+
+	/* Apply a removal read from the file, also removing the word from
+	   the provider's session if session is not null. */
+	void read_tombstone(string line, EnchantDict? session) {
+		string word = line.offset(TOMBSTONE.length);
+		if (word.length == 0 || !word.validate())
 			return;
+		this.n_tombstones++;
+		string normalized_word = this.remove_from_table(word);
+		if (session != null)
+			session.provider_remove(normalized_word);
+	}
+
+	/* If the file has only had lines appended since it was read, read the
+	   new lines and return true.  The caller must lock the file. */
+	bool read_appended(EnchantDict session, FileStream f, Posix.Stat stats, bool update_session) {
+		if (this.file_offset == 0 || (uint64)stats.st_ino != this.file_ino ||
+			(int64)stats.st_size < this.file_offset)
+			return false;
+		uint8[]? tail = read_bytes(f, this.file_offset - this.file_tail.length, this.file_tail.length);
+		if (tail == null || Memory.cmp(tail, this.file_tail, tail.length) != 0)
+			return false;
+
+		/* As when reading the whole file, a final line without a newline is
+		   taken to be complete. */
+		uint8[]? data = read_bytes(f, this.file_offset, (size_t)((int64)stats.st_size - this.file_offset));
+		if (data == null)
+			return false;
+
+		string text = ((string)data).ndup(data.length);
+		foreach (unowned string line in text.split("\n")) {
+			string word = line.chomp();
+			if (this.has_tombstones && word.has_prefix(TOMBSTONE)) {
+				this.read_tombstone(word, update_session ? session : null);
+			} else if (word[0] != '\0' && word[0] != '#') {
+				if (word.validate()) {
+					this.add_to_table(word);
+					if (update_session) {
+						string? normalized_copy;
+						session.provider_add(nfc_string(word, out normalized_copy));
+					}
+				} else
+					warning("Bad UTF-8 sequence in %s", this.filename);
+			}
+		}
+
+		this.mark_read(f, stats, this.file_offset + data.length);
+		return true;
+	}
+
+	/* Reread the file if it has changed.  Unless force is true, the file is
+	   not checked if it was checked less than refresh_interval ago.
+	   Returns true if it was reread. */
+	public bool refresh_from_file(EnchantDict session, bool force = false) {
+		if (this.filename == null)
+			return false;
+
+		int64 now = get_monotonic_time();
+		if (!force && this.refresh_interval > 0 &&
+			now - this.last_refresh < this.refresh_interval)
+			return false;
+		this.last_refresh = now;
 
 		Posix.Stat stats;
 		if (Posix.stat(this.filename, out stats) == -1)
-			return; /* presumably won't be able to open the file either */
+			return false; /* presumably won't be able to open the file either */
 		if (this.file_changed == stats.st_mtime) /* nothing changed since last read */
-			return;
+			return false;
 
 		FileStream? f = FileStream.open(this.filename, "r");
 		if (f == null)
-			return;
+			return false;
+
+		lock_file(f);
+		bool reread = this.refresh_locked(session, f);
+		unlock_file(f);
+		return reread;
+	}
+
+	/* Reread the file, which must be open for reading and locked, if it has
+	   changed since it was last read.  Returns true if it was reread. */
+	bool refresh_locked(EnchantDict session, FileStream f) {
+		Posix.Stat stats;
+		if (Posix.fstat(f.fileno(), out stats) == -1)
+			return false;
+		/* A change within the same second as the last read still changes
+		   the size, unless the file was rewritten. */
+		if (this.file_changed == stats.st_mtime && this.file_offset != 0 &&
+			this.file_offset == (int64)stats.st_size &&
+			this.file_ino == (uint64)stats.st_ino)
+			return false;
 
-		// Remove current words from session.
-		if (!this.exclude) {
+		/* With an index, the words are not added to the session; they are
+		   looked up in the index instead.  In lazy mode, the session
+		   passes them to the provider when it needs them. */
+		bool update_session = this.passes_words_to_session();
+		if (update_session && session.lazy_pwl) {
+			AtomicInt.set(ref session.pwl_pending, 1);
+			update_session = false;
+		}
+
+		/* Read just the new lines if the file has only been appended to. */
+		this.file_changed = stats.st_mtime;
+		if (this.read_appended(session, f, stats, update_session))
+			return true;
+
+		// Remove current words from the provider's session.
+		if (update_session) {
 			foreach (string w in this.words.get_keys())
-				session.remove_from_session(w, w.length);
+				session.provider_remove(w);
 		}
 
-		this.words = new HashTable<string, string>(str_hash, str_equal);
+		this.clear_table();
+		this.index = null;
+		this.removed.remove_all();
+		this.has_tombstones = false;
+		this.n_tombstones = 0;
+
+		string index_filename = this.filename + ".idx";
+		if (this.use_index) {
+			this.index = EnchantPWLIndex.open(index_filename, stats);
+			if (this.index != null) {
+				this.has_tombstones = starts_with_tombstone_header(f);
+				this.mark_read(f, stats, (int64)stats.st_size);
+				return true;
+			}
+		}
 
-		this.file_changed = stats.st_mtime;
-		lock_file(f);
+		f.rewind();
 
 		size_t line_number = 1;
 		string line;
@@ -295,7 +768,11 @@ public class EnchantPWL {
 				line = line.next_char();
 
 			line = line.chomp();
-			if (line[0] != '\0' && line[0] != '#') {
+			if (line_number == 1 && line == TOMBSTONE_HEADER) {
+				this.has_tombstones = true;
+			} else if (this.has_tombstones && line.has_prefix(TOMBSTONE)) {
+				this.read_tombstone(line, null);
+			} else if (line[0] != '\0' && line[0] != '#') {
 				if (line.validate())
 					this.add_to_table(line);
 				else
@@ -303,13 +780,33 @@ public class EnchantPWL {
 			}
 		}
 
-		unlock_file(f);
+		this.mark_read(f, stats, (int64)f.tell());
+
+		if (this.use_index) {
+			this.index = EnchantPWLIndex.create(index_filename, stats, this.words);
+			if (this.index != null)
+				this.clear_table();
+		}
 
-		// Add new words to session.
-		if (!this.exclude) {
+		// Add new words to the provider's session.
+		if (update_session) {
 			foreach (string w in this.words.get_keys())
-				session.add_to_session(w, w.length);
+				session.provider_add(w);
+		}
+
+		return true;
+	}
+
+	/* Record that the file, which must be locked, has been changed by this
+	   list, which is now up to date with it. */
+	void mark_written(FileStream f) {
+		f.flush();
+		Posix.Stat stats;
+		if (Posix.fstat(f.fileno(), out stats) == 0) {
+			this.file_changed = stats.st_mtime;
+			this.mark_read(f, stats, (int64)stats.st_size);
 		}
+		this.last_refresh = get_monotonic_time();
 	}
 }
 
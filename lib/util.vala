@@ -26,9 +26,66 @@
  * do so, delete this exception statement from your version.
  */
 
-public string? buf_to_utf8_string(string str_buf, ssize_t len) {
-	string res = str_buf.substring(0, len);
-	if (res.length == 0 || !res.validate())
+/* Return the string in the first len bytes of str_buf (up to the first nul
+   if len is negative), or null if it is empty or invalid UTF-8.  No byte
+   at or beyond len is read, as str_buf need not be nul-terminated.  If len
+   is negative or there is a nul within the first len bytes, the string is
+   returned without copying; otherwise, a copy is stored in copy, and the
+   result points to it. */
+public unowned string? buf_to_utf8_string(string str_buf, ssize_t len, out string? copy) {
+	copy = null;
+
+	long n = 0;
+	if (len < 0)
+		n = str_buf.length;
+	else
+		while (n < len && str_buf[n] != '\0')
+			n++;
+	if (n == 0 || !str_buf.validate(n))
 		return null;
+	if (len < 0 || n < len)
+		return str_buf;
+
+	copy = str_buf.ndup(n);
+	unowned string res = copy;
+	return res;
+}
+
+/* Return true if the first len bytes of the valid UTF-8 string word (up to
+   the first nul if len is negative) contain no character from U+0300 up.
+   Such characters neither decompose nor combine with their neighbours, so
+   the text is already in NFC.  ASCII text is checked eight bytes at a
+   time. */
+public bool is_nfc_quick(string word, ssize_t len = -1) {
+	size_t n = len < 0 ? word.length : (size_t)len;
+	uint8 *p = (uint8 *)word;
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		uint64 chunk;
+		Memory.copy(&chunk, p + i, 8);
+		if ((chunk & 0x8080808080808080ULL) != 0)
+			break;
+	}
+	/* The lead bytes of U+0300 and above are 0xcc and above. */
+	for (; i < n; i++)
+		if (p[i] >= 0xcc)
+			return false;
+	return true;
+}
+
+public int enchant_is_nfc_quick(string word, real_ssize_t len) {
+	return (int)is_nfc_quick(word, (ssize_t)len);
+}
+
+/* Return word in NFC.  If normalizing it might change it, the normalized
+   word is stored in copy, and the result points to it; otherwise, word is
+   returned without copying. */
+public unowned string nfc_string(string word, out string? copy) {
+	copy = null;
+	if (is_nfc_quick(word))
+		return word;
+
+	copy = word.normalize();
+	unowned string res = copy;
 	return res;
 }
@@ -305,6 +305,7 @@ extern "C" {
 			provider->identify          = appleSpell_provider_identify;
 			provider->describe          = appleSpell_provider_describe;
 			provider->list_dicts        = appleSpell_provider_list_dicts;
+			provider->serialize_dict_calls = 1;
 
 			try {
 				AppleSpellChecker * checker = new AppleSpellChecker;
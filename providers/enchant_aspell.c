@@ -53,9 +53,14 @@ aspell_dict_check (EnchantProviderDict * me, const char *const word, size_t len)
 {
 	AspellSpeller *manager = (AspellSpeller *) me->user_data;
 
-	char *normalizedWord = g_utf8_normalize (word, len, G_NORMALIZE_NFC);
-	int val = aspell_speller_check (manager, normalizedWord, strlen(normalizedWord));
-	g_free(normalizedWord);
+	int val;
+	if (enchant_is_nfc_quick (word, len))
+		val = aspell_speller_check (manager, word, len);
+	else {
+		char *normalizedWord = g_utf8_normalize (word, len, G_NORMALIZE_NFC);
+		val = aspell_speller_check (manager, normalizedWord, strlen(normalizedWord));
+		g_free(normalizedWord);
+	}
 
 	if (val == 0)
 		return 1;
@@ -73,9 +78,14 @@ aspell_dict_suggest (EnchantProviderDict * me, const char *const word,
 {
 	AspellSpeller *manager = (AspellSpeller *) me->user_data;
 
-	char *normalizedWord = g_utf8_normalize (word, len, G_NORMALIZE_NFC);
-	const AspellWordList *word_list = aspell_speller_suggest (manager, normalizedWord, strlen(normalizedWord));
-	g_free(normalizedWord);
+	const AspellWordList *word_list;
+	if (enchant_is_nfc_quick (word, len))
+		word_list = aspell_speller_suggest (manager, word, len);
+	else {
+		char *normalizedWord = g_utf8_normalize (word, len, G_NORMALIZE_NFC);
+		word_list = aspell_speller_suggest (manager, normalizedWord, strlen(normalizedWord));
+		g_free(normalizedWord);
+	}
 
 	char **sugg_arr = NULL;
 	if (word_list) {
@@ -202,6 +212,7 @@ init_enchant_provider (void)
 	provider->identify = aspell_provider_identify;
 	provider->describe = aspell_provider_describe;
 	provider->list_dicts = aspell_provider_list_dicts;
+	provider->serialize_dict_calls = 1;
 
 	return provider;
 }
@@ -271,6 +271,7 @@ init_enchant_provider (void)
 	provider->identify = hspell_provider_identify;
 	provider->describe = hspell_provider_describe;
 	provider->list_dicts = hspell_provider_list_dicts;
+	provider->serialize_dict_calls = 1;
 
 	return provider;
 }
@@ -38,6 +38,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -53,6 +56,7 @@
 #define DIC_SUFFIX ".dic"
 
 #include <glib.h>
+#include <glib/gstdio.h>
 
 /***************************************************************************/
 
@@ -78,8 +82,35 @@ static char *do_iconv(GIConv conv, const char *word) {
 	return out_buf;
 }
 
+// Like do_iconv, but converts into a reusable buffer.
+static bool do_iconv(GIConv conv, const char *word, size_t len_in, std::string &out_buf) {
+	char *in = const_cast<char *>(word);
+	size_t len_out = len_in * 3;
+	out_buf.resize(len_out);
+	char *out = &out_buf[0];
+	size_t result = g_iconv(conv, &in, &len_in, &out, &len_out);
+	if (static_cast<size_t>(-1) == result)
+		return false;
+	out_buf.resize(out - &out_buf[0]);
+	return true;
+}
+
+/*
+ * A loaded dictionary. Each handle normally has its own; if sharing is turned
+ * on, handles for the same unchanged files share one until they add or
+ * remove a word.
+ */
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Weffc++"
+struct HunspellDictionary
+{
+	HunspellDictionary(const std::string & aff, const std::string & dic)
+	: hunspell(aff.c_str(), dic.c_str()) {}
+
+	Hunspell hunspell;
+	std::mutex mutex; /* Hunspell is not thread-safe, so shared use is serialised */
+};
+
 class HunspellChecker
 {
 public:
@@ -98,10 +129,16 @@ public:
 private:
 	GIConv  m_translate_in; /* Selected translation from/to Unicode */
 	GIConv  m_translate_out;
-	Hunspell *hunspell;
+	bool m_utf8; /* The dictionary is in UTF-8, so no translation is needed */
+	std::shared_ptr<HunspellDictionary> m_dictionary;
+	bool m_shared; /* m_dictionary may be used by other handles */
+	std::string m_dic; /* The .dic file m_dictionary was loaded from */
 	EnchantProvider *me;
 	char *wordchars; /* Value returned by getWordChars() */
-	char *normalizeUtf8(const char *utf8Word, size_t len);
+	bool useDictionary(std::shared_ptr<HunspellDictionary> dictionary, bool shared);
+	bool makePrivate();
+	std::unique_lock<std::mutex> lockDictionary();
+	bool toDictionary(const std::string &nfcWord, std::string &out);
 };
 #pragma GCC diagnostic pop
 
@@ -114,13 +151,12 @@ g_iconv_is_valid(GIConv i)
 }
 
 HunspellChecker::HunspellChecker(EnchantProvider *meInit)
-: apostropheIsWordChar(false), m_translate_in(nullptr), m_translate_out(nullptr), hunspell(nullptr), me(meInit), wordchars(nullptr)
+: apostropheIsWordChar(false), m_translate_in(nullptr), m_translate_out(nullptr), m_utf8(false), m_shared(false), me(meInit), wordchars(nullptr)
 {
 }
 
 HunspellChecker::~HunspellChecker()
 {
-	delete hunspell;
 	if (g_iconv_is_valid (m_translate_in))
 		g_iconv_close(m_translate_in);
 	if (g_iconv_is_valid(m_translate_out))
@@ -128,29 +164,62 @@ HunspellChecker::~HunspellChecker()
 	free(wordchars);
 }
 
-char*
-HunspellChecker::normalizeUtf8(const char *utf8Word, size_t len)
+// Normalize a UTF-8 word to NFC in out.
+static bool
+s_normalizeUtf8(const char *utf8Word, size_t len, std::string &out)
 {
-	if (len > MAXWORDUTF8LEN
-		|| !g_iconv_is_valid(m_translate_in))
-		return NULL;
+	if (len > MAXWORDUTF8LEN)
+		return false;
 
 	// the 8bit encodings use precomposed forms
+	if (enchant_is_nfc_quick(utf8Word, len)) {
+		out.assign(utf8Word, len);
+		return true;
+	}
+
 	char *normalizedWord = g_utf8_normalize (utf8Word, len, G_NORMALIZE_NFC);
-	char *out = do_iconv(m_translate_in, normalizedWord);
+	if (normalizedWord == NULL)
+		return false;
+	out.assign(normalizedWord);
 	g_free(normalizedWord);
-	return out;
+	return true;
+}
+
+// Convert a normalized word to the dictionary's encoding in out.
+bool
+HunspellChecker::toDictionary(const std::string &nfcWord, std::string &out)
+{
+	if (m_utf8) {
+		out = nfcWord;
+		return true;
+	}
+	if (!g_iconv_is_valid(m_translate_in))
+		return false;
+	return do_iconv(m_translate_in, nfcWord.data(), nfcWord.size(), out);
+}
+
+// Lock the dictionary if it is shared.
+std::unique_lock<std::mutex>
+HunspellChecker::lockDictionary()
+{
+	if (!m_shared)
+		return std::unique_lock<std::mutex>();
+	return std::unique_lock<std::mutex>(m_dictionary->mutex);
 }
 
+// Scratch space for normalized words, reused by each thread.
+static thread_local std::string normalized;
+static thread_local std::string converted;
+
 bool
 HunspellChecker::checkWord(const char *utf8Word, size_t len)
 {
-	char *out = normalizeUtf8(utf8Word, len);
-	if (out == NULL)
+	if (!s_normalizeUtf8(utf8Word, len, normalized)
+	    || !toDictionary(normalized, converted))
 		return false;
-	bool result = hunspell->spell(std::string(out)) != 0;
-	free(out);
-	return result;
+
+	std::unique_lock<std::mutex> lock = lockDictionary();
+	return m_dictionary->hunspell.spell(converted) != 0;
 }
 
 char**
@@ -159,19 +228,21 @@ HunspellChecker::suggestWord(const char* const utf8Word, size_t len, size_t *nsu
 	if (!g_iconv_is_valid(m_translate_out))
 		return nullptr;
 
-	char *out = normalizeUtf8(utf8Word, len);
-	if (out == NULL)
+	if (!s_normalizeUtf8(utf8Word, len, normalized)
+	    || !toDictionary(normalized, converted))
 		return nullptr;
 
-	std::vector<std::string> sugMS = hunspell->suggest(out);
-	*nsug = sugMS.size();
-	g_free(out);
-	char **sug = g_new0 (char *, *nsug + 1);
+	std::vector<std::string> sugMS;
+	{
+		std::unique_lock<std::mutex> lock = lockDictionary();
+		sugMS = m_dictionary->hunspell.suggest(converted);
+	}
+
+	char **sug = g_new0 (char *, sugMS.size() + 1);
 	if (sug) {
 		size_t j = 0;
-		for (size_t i = 0; i < *nsug; i++) {
-			const char *in = sugMS[i].c_str();
-			out = do_iconv(m_translate_out, in);
+		for (size_t i = 0; i < sugMS.size(); i++) {
+			char *out = m_utf8 ? g_strdup(sugMS[i].c_str()) : do_iconv(m_translate_out, sugMS[i].c_str());
 			if (out != NULL)
 				sug[j++] = out;
 		}
@@ -184,23 +255,23 @@ HunspellChecker::suggestWord(const char* const utf8Word, size_t len, size_t *nsu
 void
 HunspellChecker::add(const char* const utf8Word, size_t len)
 {
-	char *out = normalizeUtf8(utf8Word, len);
-	if (out == NULL)
+	if (!makePrivate()
+	    || !s_normalizeUtf8(utf8Word, len, normalized)
+	    || !toDictionary(normalized, converted))
 		return;
 
-	hunspell->add(out);
-	free(out);
+	m_dictionary->hunspell.add(converted);
 }
 
 void
 HunspellChecker::remove(const char* const utf8Word, size_t len)
 {
-	char *out = normalizeUtf8(utf8Word, len);
-	if (out == NULL)
+	if (!makePrivate()
+	    || !s_normalizeUtf8(utf8Word, len, normalized)
+	    || !toDictionary(normalized, converted))
 		return;
 
-	hunspell->remove(out);
-	free(out);
+	m_dictionary->hunspell.remove(converted);
 }
 
 _GL_ATTRIBUTE_PURE const char*
@@ -257,29 +328,95 @@ hunspell_find_dictionary (EnchantProvider * me, const char * tag)
 	return nullptr;
 }
 
-bool
-HunspellChecker::requestDictionary(const char *szLang)
+/*
+ * If sharing is turned on, loaded dictionaries are kept, keyed on their
+ * files' state, so that a dictionary requested again (or by another handle)
+ * is reused unless its .dic or .aff file has changed since.
+ */
+
+#define MAX_CACHED_DICTIONARIES 4
+
+struct HunspellCacheEntry
 {
-	char *dic = hunspell_find_dictionary (me, szLang);
-	if (!dic)
-		return false;
+	std::string dic;
+	std::string stamp;
+	std::shared_ptr<HunspellDictionary> dictionary;
+};
 
-        if (hunspell) {
-                delete hunspell;
-                free(wordchars);
-                wordchars = NULL;
-        }
-	std::string aff(s_correspondingAffFile(dic));
-        hunspell = new Hunspell(aff.c_str(), dic);
-	free(dic);
-	if(hunspell == NULL)
-		return false;
-	const char *enc = hunspell->get_dic_encoding();
+static std::mutex s_cacheMutex;
+static std::list<HunspellCacheEntry> s_cache; /* most recently used first */
+
+static std::string
+s_fileStamp(const std::string & dic)
+{
+	std::string stamp;
+	for (const std::string & file : {dic, s_correspondingAffFile(dic)}) {
+		GStatBuf st;
+		if (g_stat(file.c_str(), &st) != 0)
+			return "";
+		stamp += std::to_string(st.st_mtime) + ":" + std::to_string(st.st_size) + "\n";
+	}
+	return stamp;
+}
 
+static std::shared_ptr<HunspellDictionary>
+s_getDictionary(const std::string & dic)
+{
+	std::string stamp = s_fileStamp(dic);
+	{
+		std::lock_guard<std::mutex> lock(s_cacheMutex);
+		for (auto it = s_cache.begin(); it != s_cache.end(); ++it)
+			if (it->dic == dic && it->stamp == stamp) {
+				s_cache.splice(s_cache.begin(), s_cache, it);
+				return it->dictionary;
+			}
+	}
+
+	// Parse outside the lock, so other dictionaries can be requested meanwhile
+	auto dictionary = std::make_shared<HunspellDictionary>(s_correspondingAffFile(dic), dic);
+	if (stamp.empty())
+		return dictionary;
+
+	std::lock_guard<std::mutex> lock(s_cacheMutex);
+	s_cache.push_front(HunspellCacheEntry{dic, stamp, dictionary});
+	if (s_cache.size() > MAX_CACHED_DICTIONARIES)
+		s_cache.pop_back();
+	return dictionary;
+}
+
+static void
+s_clearCache()
+{
+	std::lock_guard<std::mutex> lock(s_cacheMutex);
+	s_cache.clear();
+}
+
+// Whether ENCHANT_SHARE_DICTS asks for dictionaries to be shared.
+static bool
+s_shareDictionaries()
+{
+	const char *share = g_getenv("ENCHANT_SHARE_DICTS");
+	return share != NULL && *share != '\0' && strcmp(share, "0") != 0;
+}
+
+bool
+HunspellChecker::useDictionary(std::shared_ptr<HunspellDictionary> dictionary, bool shared)
+{
+	m_dictionary = dictionary;
+	m_shared = shared;
+	Hunspell &hunspell = m_dictionary->hunspell;
+	const char *enc = hunspell.get_dic_encoding();
+
+	if (g_iconv_is_valid(m_translate_in))
+		g_iconv_close(m_translate_in);
+	if (g_iconv_is_valid(m_translate_out))
+		g_iconv_close(m_translate_out);
 	m_translate_in = g_iconv_open(enc, "UTF-8");
 	m_translate_out = g_iconv_open("UTF-8", enc);
+	m_utf8 = g_ascii_strcasecmp(enc, "UTF-8") == 0;
 
-	wordchars = do_iconv(m_translate_out, hunspell->get_wordchars());
+	free(wordchars);
+	wordchars = do_iconv(m_translate_out, hunspell.get_wordchars());
 	if (wordchars == NULL)
 		wordchars = strdup(empty_string);
 	if (wordchars == NULL)
@@ -290,6 +427,30 @@ HunspellChecker::requestDictionary(const char *szLang)
 	return true;
 }
 
+// Give a handle that shares its dictionary a copy of its own, so that the
+// words added to or removed from its session are not seen by other handles.
+bool
+HunspellChecker::makePrivate()
+{
+	if (!m_shared)
+		return true;
+	return useDictionary(std::make_shared<HunspellDictionary>(s_correspondingAffFile(m_dic), m_dic), false);
+}
+
+bool
+HunspellChecker::requestDictionary(const char *szLang)
+{
+	char *dic = hunspell_find_dictionary (me, szLang);
+	if (!dic)
+		return false;
+
+	m_dic = dic;
+	free(dic);
+	if (s_shareDictionaries())
+		return useDictionary(s_getDictionary(m_dic), true);
+	return useDictionary(std::make_shared<HunspellDictionary>(s_correspondingAffFile(m_dic), m_dic), false);
+}
+
 /*
  * Enchant
  */
@@ -313,6 +474,16 @@ hunspell_dict_check (EnchantProviderDict * me, const char *const word, size_t le
 	return 1;
 }
 
+static void
+hunspell_dict_check_many (EnchantProviderDict * me, const char *const *words,
+			  const size_t *lens, size_t n, int *results)
+{
+	HunspellChecker * checker = static_cast<HunspellChecker *>(me->user_data);
+
+	for (size_t i = 0; i < n; i++)
+		results[i] = checker->checkWord(words[i], lens[i]) ? 0 : 1;
+}
+
 static void
 hunspell_dict_add_to_session (EnchantProviderDict * me,
 			      const char *const word, size_t len)
@@ -400,6 +571,19 @@ hunspell_provider_list_dicts (EnchantProvider * me, size_t * out_n_dicts)
 	return dictionary_list;
 }
 
+static char **
+hunspell_provider_list_dict_dirs (EnchantProvider * me, size_t * out_n_dirs)
+{
+	std::vector<std::string> dict_dirs;
+	s_buildDictionaryDirs (me, dict_dirs);
+
+	char ** dir_list = g_new0 (char *, dict_dirs.size() + 1);
+	for (size_t i = 0; i < dict_dirs.size(); i++)
+		dir_list[i] = g_strdup (dict_dirs[i].c_str());
+	*out_n_dirs = dict_dirs.size ();
+	return dir_list;
+}
+
 static EnchantProviderDict *
 hunspell_provider_request_dict(EnchantProvider * me, const char *const tag)
 {
@@ -423,6 +607,7 @@ hunspell_provider_request_dict(EnchantProvider * me, const char *const tag)
 	dict->remove_from_session = hunspell_dict_remove_from_session;
 	dict->get_extra_word_characters = hunspell_dict_get_extra_word_characters;
 	dict->is_word_character = hunspell_dict_is_word_character;
+	dict->check_many = hunspell_dict_check_many;
 
 	return dict;
 }
@@ -456,6 +641,7 @@ hunspell_provider_describe (EnchantProvider * me _GL_UNUSED)
 static void
 hunspell_provider_dispose (EnchantProvider * me _GL_UNUSED)
 {
+	s_clearCache();
 	provider = NULL;
 }
 
@@ -472,6 +658,8 @@ init_enchant_provider (void)
 	provider->identify = hunspell_provider_identify;
 	provider->describe = hunspell_provider_describe;
 	provider->list_dicts = hunspell_provider_list_dicts;
+	provider->list_dict_dirs = hunspell_provider_list_dict_dirs;
+	provider->serialize_dict_calls = 1;
 
 	return provider;
 }
@@ -37,6 +37,8 @@
 #include "config.h"
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "enchant-provider.h"
 
@@ -49,11 +51,27 @@ using namespace std;
 
 static EnchantProvider *provider;
 
+// Dictionaries are not changed once loaded, so all the requests for a
+// dictionary share one copy while it is in use, as long as its files have
+// not changed.
+using Shared_Dictionary = shared_ptr<const nuspell::Dictionary>;
+
+struct Cached_Dictionary {
+	string stamp;
+	weak_ptr<const nuspell::Dictionary> dict;
+};
+
+static mutex dict_cache_mutex;
+static unordered_map<string, Cached_Dictionary> dict_cache;
+
 // EnchantProviderDict functions
 static int nuspell_dict_check(EnchantProviderDict* me, const char* const word,
                               size_t len)
 {
-	auto dict = static_cast<nuspell::Dictionary*>(me->user_data);
+	auto& dict = *static_cast<Shared_Dictionary*>(me->user_data);
+
+	if (enchant_is_nfc_quick(word, len))
+		return !dict->spell(string_view(word, len));
 
 	using UniquePtr = unique_ptr<char[], decltype(&g_free)>;
 	auto normalized_word =
@@ -64,14 +82,18 @@ static int nuspell_dict_check(EnchantProviderDict* me, const char* const word,
 static char** nuspell_dict_suggest(EnchantProviderDict* me, const char* const word,
                                    size_t len, size_t* out_n_suggs)
 {
-	auto dict = static_cast<nuspell::Dictionary*>(me->user_data);
+	auto& dict = *static_cast<Shared_Dictionary*>(me->user_data);
 
 	using UniquePtr = unique_ptr<char[], decltype(&g_free)>;
 	// the 8-bit encodings use precomposed forms
-	auto normalized_word =
-	    UniquePtr(g_utf8_normalize(word, len, G_NORMALIZE_NFC), g_free);
+	auto normalized_word = UniquePtr(nullptr, g_free);
+	auto normalized = string_view(word, len);
+	if (!enchant_is_nfc_quick(word, len)) {
+		normalized_word.reset(g_utf8_normalize(word, len, G_NORMALIZE_NFC));
+		normalized = normalized_word.get();
+	}
 	auto suggestions = vector<string>();
-	dict->suggest(normalized_word.get(), suggestions);
+	dict->suggest(normalized, suggestions);
 	char** sug_list = g_new0(char*, size(suggestions) + 1);
 	if (sug_list) {
 		transform(begin(suggestions), end(suggestions), sug_list,
@@ -95,6 +117,64 @@ nuspell_get_dict_dirs(EnchantProvider *me)
 	return dirs;
 }
 
+// Returns a string that changes when the dictionary's files change, or an
+// empty string if they cannot be examined.
+static string
+nuspell_file_stamp(const filesystem::path& dic_path)
+{
+	auto stamp = string();
+	auto aff_path = dic_path;
+	aff_path.replace_extension(".aff");
+	for (auto& path : {dic_path, aff_path}) {
+		auto ec = error_code();
+		auto mtime = filesystem::last_write_time(path, ec);
+		if (ec)
+			return string();
+		auto size = filesystem::file_size(path, ec);
+		if (ec)
+			return string();
+		stamp += to_string(mtime.time_since_epoch().count()) + ":" +
+		         to_string(size) + "\n";
+	}
+	return stamp;
+}
+
+static Shared_Dictionary
+nuspell_load_dict(const filesystem::path& dic_path)
+{
+	auto key = dic_path.string();
+	auto stamp = nuspell_file_stamp(dic_path);
+	if (!empty(stamp)) {
+		auto lock = lock_guard<mutex>(dict_cache_mutex);
+		auto it = dict_cache.find(key);
+		if (it != end(dict_cache) && it->second.stamp == stamp) {
+			auto dict_cpp = it->second.dict.lock();
+			if (dict_cpp)
+				return dict_cpp;
+		}
+	}
+
+	auto dict_cpp = make_shared<nuspell::Dictionary>();
+	try {
+		dict_cpp->load_aff_dic(dic_path);
+	}
+	catch (const nuspell::Dictionary_Loading_Error&) {
+		return nullptr;
+	}
+
+	if (!empty(stamp)) {
+		auto lock = lock_guard<mutex>(dict_cache_mutex);
+		// Forget dictionaries that are no longer in use.
+		for (auto it = begin(dict_cache); it != end(dict_cache);)
+			if (it->second.dict.expired())
+				it = dict_cache.erase(it);
+			else
+				++it;
+		dict_cache[key] = Cached_Dictionary{stamp, dict_cpp};
+	}
+	return dict_cpp;
+}
+
 static EnchantProviderDict*
 nuspell_provider_request_dict(EnchantProvider* me,
                               const char* const tag)
@@ -104,18 +184,14 @@ nuspell_provider_request_dict(EnchantProvider* me,
 	if (empty(dic_path))
 		return nullptr;
 
-	auto dict_cpp = make_unique<nuspell::Dictionary>();
-	try {
-		dict_cpp->load_aff_dic(dic_path);
-	}
-	catch (const nuspell::Dictionary_Loading_Error&) {
+	auto dict_cpp = nuspell_load_dict(dic_path);
+	if (!dict_cpp)
 		return nullptr;
-	}
 
 	EnchantProviderDict* dict = enchant_provider_dict_new(provider, tag);
 	if (dict == nullptr)
 		return nullptr;
-	dict->user_data = static_cast<void*>(dict_cpp.release());
+	dict->user_data = static_cast<void*>(new Shared_Dictionary(dict_cpp));
 	dict->check = nuspell_dict_check;
 	dict->suggest = nuspell_dict_suggest;
 	return dict;
@@ -124,7 +200,7 @@ nuspell_provider_request_dict(EnchantProvider* me,
 static void nuspell_provider_dispose_dict(_GL_UNUSED EnchantProvider* me,
                                           EnchantProviderDict* dict)
 {
-	auto dict_cpp = static_cast<nuspell::Dictionary*>(dict->user_data);
+	auto dict_cpp = static_cast<Shared_Dictionary*>(dict->user_data);
 	delete dict_cpp;
 }
 
@@ -179,6 +255,20 @@ nuspell_provider_list_dicts(EnchantProvider* me,
 	return dictionary_list;
 }
 
+static char**
+nuspell_provider_list_dict_dirs(EnchantProvider* me,
+                                size_t* out_n_dirs)
+{
+	auto dirs = nuspell_get_dict_dirs(me);
+	char** dir_list = g_new0(char*, size(dirs) + 1);
+	transform(begin(dirs), end(dirs), dir_list,
+		  [](const filesystem::path& p) {
+			  return g_strdup(p.string().c_str());
+		  });
+	*out_n_dirs = size(dirs);
+	return dir_list;
+}
+
 static void
 nuspell_provider_dispose (_GL_UNUSED EnchantProvider *me)
 {
@@ -198,6 +288,7 @@ init_enchant_provider (void)
 	provider->identify = nuspell_provider_identify;
 	provider->describe = nuspell_provider_describe;
 	provider->list_dicts = nuspell_provider_list_dicts;
+	provider->list_dict_dirs = nuspell_provider_list_dict_dirs;
 
 	return provider;
 }
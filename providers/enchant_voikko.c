@@ -190,6 +190,7 @@ init_enchant_provider (void)
 	provider->identify = voikko_provider_identify;
 	provider->describe = voikko_provider_describe;
 	provider->list_dicts = voikko_provider_list_dicts;
+	provider->serialize_dict_calls = 1;
 
 	return provider;
 }
@@ -323,6 +323,7 @@ init_enchant_provider(void)
 	provider->identify = winspell_provider_identify;
 	provider->describe = winspell_provider_describe;
 	provider->list_dicts = winspell_provider_list_dicts;
+	provider->serialize_dict_calls = 1;
 
 	return provider;
 }
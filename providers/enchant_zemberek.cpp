@@ -249,6 +249,7 @@ init_enchant_provider(void)
     provider->identify = zemberek_provider_identify;
     provider->describe = zemberek_provider_describe;
     provider->list_dicts = zemberek_provider_list_dicts;
+    provider->serialize_dict_calls = 1;
 
     return provider;
 }
@@ -58,6 +58,10 @@ struct EnchantTestFixture
         DeleteDirAndFiles(GetTempUserEnchantDir());
         DeleteDirAndFiles(AddToPath(LIBDIR_SUBDIR, "enchant-" ENCHANT_MAJOR_VERSION));
         DeleteDirAndFiles("share");
+        // The dictionary index, when the tests have their own cache directory
+        const char* cacheDir = getenv("XDG_CACHE_HOME");
+        if (cacheDir != NULL)
+            DeleteDirAndFiles(AddToPath(cacheDir, "enchant"));
     }
 
     std::string GetTempUserEnchantDir()
@@ -38,3 +38,10 @@ TEST(EnchantBrokerInit_CreatesObject)
     CHECK(broker);
     enchant_broker_free(broker);
 }
+
+TEST(EnchantBrokerInitLazy_CreatesObject)
+{
+    EnchantBroker *broker = enchant_broker_init_lazy();
+    CHECK(broker);
+    enchant_broker_free(broker);
+}
@@ -176,3 +176,113 @@ TEST_FIXTURE(EnchantBrokerListDictionaries_ProviderDuplicateTags_TestFixture,
     enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
     CHECK_EQUAL((unsigned int)1, _dictionaryList.size());
 }
+
+static int listDictionariesCalls;
+static std::string indexedDictionaryDir;
+static char** CountListDictionaries (EnchantProvider * me, size_t * out_n_dicts)
+{
+   listDictionariesCalls++;
+   return MockEnGbProviderListDictionaries(me, out_n_dicts);
+}
+
+static char** ListDictionaryDirs (EnchantProvider *, size_t * out_n_dirs)
+{
+    *out_n_dirs = 1;
+    char** out_list = g_new0 (char *, *out_n_dirs + 1);
+    out_list[0] = g_strdup (indexedDictionaryDir.c_str());
+
+    return out_list;
+}
+
+static void List_Dictionaries_ProviderConfigurationIndexed (EnchantProvider * me)
+{
+     me->list_dicts=CountListDictionaries;
+     me->list_dict_dirs=ListDictionaryDirs;
+}
+
+static int dictionaryExistsCalls;
+static int DoesDictionaryExist (EnchantProvider *, const char *const tag)
+{
+    dictionaryExistsCalls++;
+    return strcmp(tag, "qaa") == 0;
+}
+
+static void List_Dictionaries_ProviderConfigurationIndexedWithExists (EnchantProvider * me)
+{
+     List_Dictionaries_ProviderConfigurationIndexed(me);
+     me->dictionary_exists=DoesDictionaryExist;
+}
+
+struct EnchantBrokerListDictionaries_Indexed_TestFixture : EnchantBrokerListDictionaries_TestFixtureBase
+{
+    //Setup
+    EnchantBrokerListDictionaries_Indexed_TestFixture():
+            EnchantBrokerListDictionaries_TestFixtureBase(List_Dictionaries_ProviderConfigurationIndexed)
+    {
+        listDictionariesCalls = 0;
+        // A directory that does not exist yet, so its modification time
+        // cannot change within the test.
+        indexedDictionaryDir = AddToPath(GetTempUserEnchantDir(), "mock");
+    }
+};
+
+TEST_FIXTURE(EnchantBrokerListDictionaries_Indexed_TestFixture,
+             EnchantBrokerListDictionaries_Indexed_ProviderListsOnce)
+{
+    enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
+    enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
+    CHECK_EQUAL(1, listDictionariesCalls);
+    CHECK_EQUAL((unsigned int)2, _dictionaryList.size());
+    CHECK_EQUAL(1, enchant_broker_dict_exists(_broker, "en_GB"));
+    CHECK_EQUAL(1, listDictionariesCalls);
+}
+
+TEST_FIXTURE(EnchantBrokerListDictionaries_Indexed_TestFixture,
+             EnchantBrokerListDictionaries_Indexed_IndexUsedByNewBroker)
+{
+    enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
+    enchant_broker_free(_broker);
+    _broker = enchant_broker_init();
+    enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
+    CHECK_EQUAL(1, listDictionariesCalls);
+    CHECK_EQUAL((unsigned int)2, _dictionaryList.size());
+}
+
+TEST_FIXTURE(EnchantBrokerListDictionaries_Indexed_TestFixture,
+             EnchantBrokerListDictionaries_Indexed_DirectoryChanged_ProviderListsAgain)
+{
+    enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
+    CreateDirectory(indexedDictionaryDir);
+    enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
+    CHECK_EQUAL(2, listDictionariesCalls);
+}
+
+struct EnchantBrokerListDictionaries_IndexedWithExists_TestFixture : EnchantBrokerListDictionaries_TestFixtureBase
+{
+    //Setup
+    EnchantBrokerListDictionaries_IndexedWithExists_TestFixture():
+            EnchantBrokerListDictionaries_TestFixtureBase(List_Dictionaries_ProviderConfigurationIndexedWithExists)
+    {
+        listDictionariesCalls = 0;
+        dictionaryExistsCalls = 0;
+        indexedDictionaryDir = AddToPath(GetTempUserEnchantDir(), "mock");
+    }
+};
+
+TEST_FIXTURE(EnchantBrokerListDictionaries_IndexedWithExists_TestFixture,
+             EnchantBrokerListDictionaries_IndexedWithExists_ListedDictionaryFoundInIndex)
+{
+    enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
+    CHECK_EQUAL(1, enchant_broker_dict_exists(_broker, "en_GB"));
+    CHECK_EQUAL(0, dictionaryExistsCalls);
+    CHECK_EQUAL(1, listDictionariesCalls);
+}
+
+TEST_FIXTURE(EnchantBrokerListDictionaries_IndexedWithExists_TestFixture,
+             EnchantBrokerListDictionaries_IndexedWithExists_MissAsksProvider)
+{
+    enchant_broker_list_dicts(_broker, EnchantDictionaryDescribeCallback, &_dictionaryList);
+    CHECK_EQUAL(1, enchant_broker_dict_exists(_broker, "qaa"));
+    CHECK_EQUAL(1, dictionaryExistsCalls);
+    CHECK_EQUAL(1, listDictionariesCalls);
+}
@@ -25,9 +25,11 @@
 #include "EnchantBrokerTestFixture.h"
 
 static bool requestDictionaryCalled;
+static int requestDictionaryCalls;
 static EnchantProviderDict * RequestDictionary (EnchantProvider *me, const char *tag)
 {
     requestDictionaryCalled = true;
+    requestDictionaryCalls++;
     return MockEnGbAndQaaProviderRequestDictionary(me, tag);
 }
 
@@ -37,14 +39,43 @@ static void Request_Dictionary_ProviderConfiguration (EnchantProvider * me)
      me->dispose_dict = MockProviderDisposeDictionary;
 }
 
+static int addToSessionCalls;
+static void AddToSession (EnchantProviderDict *, const char *const, size_t)
+{
+    addToSessionCalls++;
+}
+
+static int CheckNoWords (EnchantProviderDict *, const char *const, size_t)
+{
+    return 1;
+}
+
+static EnchantProviderDict * RequestCheckingDictionary (EnchantProvider *me, const char *tag)
+{
+    EnchantProviderDict *dict = RequestDictionary(me, tag);
+    if (dict) {
+        dict->check = CheckNoWords;
+        dict->add_to_session = AddToSession;
+    }
+    return dict;
+}
+
+static void Request_CheckingDictionary_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = RequestCheckingDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
 struct EnchantBrokerRequestDictionary_TestFixture : EnchantBrokerTestFixture
 {
     //Setup
-    EnchantBrokerRequestDictionary_TestFixture():
-            EnchantBrokerTestFixture(Request_Dictionary_ProviderConfiguration)
+    EnchantBrokerRequestDictionary_TestFixture(ConfigureHook userConfiguration = Request_Dictionary_ProviderConfiguration):
+            EnchantBrokerTestFixture(userConfiguration)
     { 
+        addToSessionCalls = 0;
         _dict = NULL;
         requestDictionaryCalled = false;
+        requestDictionaryCalls = 0;
     }
 
     //Teardown
@@ -217,3 +248,113 @@ TEST_FIXTURE(EnchantBrokerTestFixture,
     CHECK_EQUAL((void*)NULL, dict);
     CHECK(!requestDictionaryCalled);
 }
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Shared Dictionaries
+TEST_FIXTURE(EnchantBrokerRequestDictionary_TestFixture,
+             EnchantBrokerRequestDictionary_NotShared_CallsProviderEachTime)
+{
+    _dict = enchant_broker_request_dict(_broker, "en_GB");
+    EnchantDict* dict = enchant_broker_request_dict(_broker, "en_GB");
+    CHECK(dict);
+    CHECK_EQUAL(2, requestDictionaryCalls);
+    FreeDictionary(dict);
+}
+
+TEST_FIXTURE(EnchantBrokerRequestDictionary_TestFixture,
+             EnchantBrokerRequestDictionary_Shared_CallsProviderOnce)
+{
+    enchant_broker_set_share_dicts(_broker, 1);
+    _dict = enchant_broker_request_dict(_broker, "en_GB");
+    EnchantDict* dict = enchant_broker_request_dict(_broker, "en_GB");
+    CHECK(dict);
+    CHECK(dict != _dict);
+    CHECK_EQUAL(1, requestDictionaryCalls);
+    FreeDictionary(dict);
+}
+
+TEST_FIXTURE(EnchantBrokerRequestDictionary_TestFixture,
+             EnchantBrokerRequestDictionary_SharedAllFreed_CallsProviderAgain)
+{
+    enchant_broker_set_share_dicts(_broker, 1);
+    EnchantDict* dict = enchant_broker_request_dict(_broker, "en_GB");
+    FreeDictionary(dict);
+    _dict = enchant_broker_request_dict(_broker, "en_GB");
+    CHECK(_dict);
+    CHECK_EQUAL(2, requestDictionaryCalls);
+}
+
+TEST_FIXTURE(EnchantBrokerRequestDictionary_TestFixture,
+             EnchantBrokerRequestDictionary_Shared_SessionsSeparate)
+{
+    enchant_broker_set_share_dicts(_broker, 1);
+    _dict = enchant_broker_request_dict(_broker, "en_GB");
+    EnchantDict* dict = enchant_broker_request_dict(_broker, "en_GB");
+    enchant_dict_add_to_session(dict, "session", -1);
+    CHECK_EQUAL(1, enchant_dict_is_added(dict, "session", -1));
+    CHECK_EQUAL(0, enchant_dict_is_added(_dict, "session", -1));
+    FreeDictionary(dict);
+}
+
+struct EnchantBrokerRequestCheckingDictionary_TestFixture : EnchantBrokerRequestDictionary_TestFixture
+{
+    //Setup
+    EnchantBrokerRequestCheckingDictionary_TestFixture():
+            EnchantBrokerRequestDictionary_TestFixture(Request_CheckingDictionary_ProviderConfiguration)
+    { }
+};
+
+TEST_FIXTURE(EnchantBrokerRequestCheckingDictionary_TestFixture,
+             EnchantBrokerRequestDictionary_Shared_SessionWordsNotSeenByOtherSession)
+{
+    enchant_broker_set_share_dicts(_broker, 1);
+    _dict = enchant_broker_request_dict(_broker, "en_GB");
+    EnchantDict* dict = enchant_broker_request_dict(_broker, "en_GB");
+    CHECK_EQUAL(1, requestDictionaryCalls);
+
+    enchant_dict_add_to_session(dict, "session", -1);
+    CHECK_EQUAL(0, enchant_dict_check(dict, "session", -1));
+    CHECK_EQUAL(1, enchant_dict_check(_dict, "session", -1));
+    // The provider dictionary both sessions use is left alone
+    CHECK_EQUAL(0, addToSessionCalls);
+    FreeDictionary(dict);
+}
+
+TEST_FIXTURE(EnchantBrokerRequestCheckingDictionary_TestFixture,
+             EnchantBrokerRequestDictionary_Shared_PersonalWordsNotPassedToProvider)
+{
+    enchant_broker_set_share_dicts(_broker, 1);
+    _dict = enchant_broker_request_dict(_broker, "en_GB");
+    EnchantDict* dict = enchant_broker_request_dict(_broker, "en_GB");
+
+    enchant_dict_add(dict, "personal", -1);
+    // The other session reads the word from the personal word list
+    CHECK_EQUAL(0, enchant_dict_check(_dict, "personal", -1));
+    CHECK_EQUAL(0, addToSessionCalls);
+    FreeDictionary(dict);
+}
+
+TEST_FIXTURE(EnchantBrokerRequestDictionary_TestFixture,
+             EnchantBrokerRequestDictionary_SharedByEnvironment_CallsProviderOnce)
+{
+    enchant_broker_free(_broker);
+    g_setenv("ENCHANT_SHARE_DICTS", "1", TRUE);
+    _broker = enchant_broker_init();
+    g_unsetenv("ENCHANT_SHARE_DICTS");
+
+    _dict = enchant_broker_request_dict(_broker, "en_GB");
+    EnchantDict* dict = enchant_broker_request_dict(_broker, "en_GB");
+    CHECK(dict);
+    CHECK_EQUAL(1, requestDictionaryCalls);
+    FreeDictionary(dict);
+}
+
+TEST_FIXTURE(EnchantBrokerRequestDictionary_TestFixture,
+             EnchantBrokerRequestDictionary_Lazy_ProviderLoadedOnRequest)
+{
+    enchant_broker_free(_broker);
+    _broker = enchant_broker_init_lazy();
+    _dict = enchant_broker_request_dict(_broker, "en_GB");
+    CHECK(_dict);
+    CHECK(requestDictionaryCalled);
+}
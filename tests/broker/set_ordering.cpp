@@ -140,6 +140,15 @@ TEST_FIXTURE(EnchantBrokerSetOrdering_TestFixture,
 	CHECK_EQUAL(Mock1ThenMock2, GetProviderOrder("qaa"));
 }
 
+TEST_FIXTURE(EnchantBrokerSetOrdering_TestFixture,
+			 EnchantBrokerSetOrdering_LazyBroker_ProviderNamesDifferFromFileNames)
+{
+	enchant_broker_free(_broker);
+	_broker = enchant_broker_init_lazy();
+	enchant_broker_set_ordering(_broker, "*", "mock2,mock1");
+	CHECK_EQUAL(Mock2ThenMock1, GetProviderOrder("qaa"));
+}
+
 TEST_FIXTURE(EnchantBrokerSetOrdering_TestFixture,
 			 EnchantBrokerSetOrdering_NoSpaces)
 {
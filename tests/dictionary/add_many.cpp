@@ -0,0 +1,153 @@
+/* Copyright (c) 2026 Reuben Thomas
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <enchant.h>
+#include "EnchantDictionaryTestFixture.h"
+#include <glib/gstdio.h>
+#include <utime.h>
+
+struct EnchantDictionaryAddMany_TestFixture : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionaryAddMany_TestFixture():
+            EnchantDictionaryTestFixture(BasicDictionary_ProviderConfiguration)
+    { }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Normal Operation
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_WordsExistInDictionaryAndSession)
+{
+    const char *words[] = {"hello", "world"};
+    enchant_dict_add_many(_dict, words, NULL, 2);
+
+    CHECK(IsWordInDictionary("hello"));
+    CHECK(IsWordInDictionary("world"));
+    CHECK(IsWordInSession("hello"));
+    CHECK(IsWordInSession("world"));
+}
+
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_LensUsed)
+{
+    const char *words[] = {"helloworld", "world"};
+    ssize_t lens[] = {5, -1};
+    enchant_dict_add_many(_dict, words, lens, 2);
+
+    CHECK(IsWordInDictionary("hello"));
+    CHECK(!IsWordInDictionary("helloworld"));
+    CHECK(IsWordInDictionary("world"));
+}
+
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_IsPermanent)
+{
+    const char *words[] = {"hello", "world"};
+    enchant_dict_add_many(_dict, words, NULL, 2);
+    CHECK(PersonalWordListFileHasContents());
+
+    ReloadTestDictionary();
+
+    CHECK(IsWordInDictionary("hello"));
+    CHECK(IsWordInDictionary("world"));
+}
+
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_WordsExistInExclude_RemovedFromExclude)
+{
+    enchant_dict_remove(_dict, "hello", -1);
+    enchant_dict_remove(_dict, "world", -1);
+    CHECK(ExcludeFileHasContents());
+
+    const char *words[] = {"hello", "world"};
+    enchant_dict_add_many(_dict, words, NULL, 2);
+
+    CHECK(!ExcludeFileHasContents());
+    CHECK(IsWordInDictionary("hello"));
+    CHECK(IsWordInDictionary("world"));
+}
+
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_HasPreviousError_ErrorCleared)
+{
+    SetErrorOnMockDictionary("something bad happened");
+
+    const char *words[] = {"hello"};
+    enchant_dict_add_many(_dict, words, NULL, 1);
+
+    CHECK_EQUAL((void*)NULL, (void*)enchant_dict_get_error(_dict));
+}
+
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_ExternalAdditionWithSameModificationTime_Seen)
+{
+    const char *words[] = {"hello"};
+    enchant_dict_add_many(_dict, words, NULL, 1);
+
+    // Another process appends a word within the same second
+    std::string pwl = GetPersonalDictFileName();
+    GStatBuf st;
+    g_stat(pwl.c_str(), &st);
+    FILE * f = g_fopen(pwl.c_str(), "a");
+    fputs("world\n", f);
+    fclose(f);
+    struct utimbuf times;
+    times.actime = st.st_atime;
+    times.modtime = st.st_mtime;
+    g_utime(pwl.c_str(), &times);
+
+    const char *more_words[] = {"foo"};
+    enchant_dict_add_many(_dict, more_words, NULL, 1);
+
+    CHECK_EQUAL(1, enchant_dict_is_added(_dict, "world", -1));
+    CHECK_EQUAL(1, enchant_dict_is_added(_dict, "foo", -1));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Error Conditions
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_NullWordsIgnored)
+{
+    const char *words[] = {NULL, "hello", ""};
+    enchant_dict_add_many(_dict, words, NULL, 3);
+
+    CHECK(IsWordInDictionary("hello"));
+}
+
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_InvalidUtf8Ignored)
+{
+    const char *words[] = {"\xa5\xf1\x08", "hello"};
+    enchant_dict_add_many(_dict, words, NULL, 2);
+
+    CHECK(IsWordInDictionary("hello"));
+}
+
+TEST_FIXTURE(EnchantDictionaryAddMany_TestFixture,
+             EnchantDictionaryAddMany_NoWords_NothingWritten)
+{
+    const char *words[] = {"hello"};
+    enchant_dict_add_many(_dict, words, NULL, 0);
+
+    CHECK(!PersonalWordListFileHasContents());
+}
@@ -73,9 +73,22 @@ struct EnchantDictionaryCheck_TestFixture_qaaqaa : EnchantDictionaryTestFixture
     }
 };
 
+struct EnchantDictionaryCheck_TestFixture_qaaqaa_parallel : EnchantDictionaryCheck_TestFixture_qaaqaa
+{
+    //Setup
+    EnchantDictionaryCheck_TestFixture_qaaqaa_parallel()
+    {
+        enchant_dict_set_parallel(_dict, 1);
+    }
+};
+
 #define EnchantDictionaryCheck_TestFixture EnchantDictionaryCheck_TestFixture_qaa
 #include "check.i"
 
 #undef EnchantDictionaryCheck_TestFixture
 #define EnchantDictionaryCheck_TestFixture EnchantDictionaryCheck_TestFixture_qaaqaa
 #include "check.i"
+
+#undef EnchantDictionaryCheck_TestFixture
+#define EnchantDictionaryCheck_TestFixture EnchantDictionaryCheck_TestFixture_qaaqaa_parallel
+#include "check.i"
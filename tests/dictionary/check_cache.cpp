@@ -0,0 +1,157 @@
+/* Copyright (c) 2026 Reuben Thomas
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <enchant.h>
+#include "EnchantDictionaryTestFixture.h"
+
+static int dictCheckCalls;
+
+static int
+MockDictionaryCheckHello (EnchantProviderDict *, const char *const word, size_t len)
+{
+    dictCheckCalls++;
+    if(strncmp("hello", word, len)==0)
+    {
+        return 0; //good word
+    }
+    return 1; // bad word
+}
+
+static void
+MockDictionaryAddToSession (EnchantProviderDict *, const char *const, size_t)
+{
+}
+
+static EnchantProviderDict* MockProviderRequestCheckMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestBasicMockDictionary(me, tag);
+    dict->check = MockDictionaryCheckHello;
+    dict->add_to_session = MockDictionaryAddToSession;
+    return dict;
+}
+
+static void DictionaryCheckCache_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestCheckMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
+struct EnchantDictionaryCheckCache_TestFixture : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionaryCheckCache_TestFixture():
+            EnchantDictionaryTestFixture(DictionaryCheckCache_ProviderConfiguration)
+    {
+        dictCheckCalls = 0;
+        enchant_dict_set_check_cache_size(_dict, 2);
+    }
+
+    void CheckStats(size_t expectedHits, size_t expectedMisses)
+    {
+        size_t hits, misses;
+        enchant_dict_get_check_cache_stats(_dict, &hits, &misses);
+        CHECK_EQUAL(expectedHits, hits);
+        CHECK_EQUAL(expectedMisses, misses);
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Normal Operation
+TEST_FIXTURE(EnchantDictionaryCheckCache_TestFixture,
+             EnchantDictionaryCheckCache_RepeatedWord_CallsProviderOnce)
+{
+    CHECK_EQUAL(0, enchant_dict_check(_dict, "hello", -1));
+    CHECK_EQUAL(0, enchant_dict_check(_dict, "hello", -1));
+    CHECK_EQUAL(1, enchant_dict_check(_dict, "helo", -1));
+    CHECK_EQUAL(1, enchant_dict_check(_dict, "helo", -1));
+    CHECK_EQUAL(2, dictCheckCalls);
+    CheckStats(2, 2);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckCache_TestFixture,
+             EnchantDictionaryCheckCache_CheckMany_UsesCache)
+{
+    const char *words[] = {"hello", "helo", "hello"};
+    int results[3];
+
+    enchant_dict_check(_dict, "hello", -1);
+    enchant_dict_check_many(_dict, words, NULL, 3, results);
+    CHECK_EQUAL(0, results[0]);
+    CHECK_EQUAL(1, results[1]);
+    CHECK_EQUAL(0, results[2]);
+    CHECK_EQUAL(2, dictCheckCalls);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckCache_TestFixture,
+             EnchantDictionaryCheckCache_Full_EvictsUnusedWord)
+{
+    enchant_dict_check(_dict, "hello", -1);
+    enchant_dict_check(_dict, "helo", -1);
+    enchant_dict_check(_dict, "hello", -1);
+    enchant_dict_check(_dict, "hell", -1);
+    CHECK_EQUAL(3, dictCheckCalls);
+
+    enchant_dict_check(_dict, "hell", -1);
+    CHECK_EQUAL(3, dictCheckCalls);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckCache_TestFixture,
+             EnchantDictionaryCheckCache_AddToSession_Invalidates)
+{
+    enchant_dict_check(_dict, "helo", -1);
+    enchant_dict_add_to_session(_dict, "session", -1);
+    enchant_dict_check(_dict, "helo", -1);
+    CHECK_EQUAL(2, dictCheckCalls);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckCache_TestFixture,
+             EnchantDictionaryCheckCache_Add_WordInPersonal)
+{
+    CHECK_EQUAL(1, enchant_dict_check(_dict, "helo", -1));
+    enchant_dict_add(_dict, "helo", -1);
+    CHECK_EQUAL(0, enchant_dict_check(_dict, "helo", -1));
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckCache_TestFixture,
+             EnchantDictionaryCheckCache_Remove_WordExcluded)
+{
+    CHECK_EQUAL(0, enchant_dict_check(_dict, "hello", -1));
+    enchant_dict_remove(_dict, "hello", -1);
+    CHECK_EQUAL(1, enchant_dict_check(_dict, "hello", -1));
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckCache_TestFixture,
+             EnchantDictionaryCheckCache_Disabled_NoStats)
+{
+    enchant_dict_set_check_cache_size(_dict, 0);
+    enchant_dict_check(_dict, "hello", -1);
+    enchant_dict_check(_dict, "hello", -1);
+    CHECK_EQUAL(2, dictCheckCalls);
+    CheckStats(0, 0);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckCache_TestFixture,
+             EnchantDictionaryCheckCache_NullStats_DoesNotCrash)
+{
+    enchant_dict_check(_dict, "hello", -1);
+    enchant_dict_get_check_cache_stats(_dict, NULL, NULL);
+}
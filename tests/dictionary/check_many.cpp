@@ -0,0 +1,216 @@
+/* Copyright (c) 2026 Reuben Thomas
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <enchant.h>
+#include "EnchantDictionaryTestFixture.h"
+
+static int dictCheckCalls;
+static int dictCheckManyCalls;
+static size_t dictCheckManyWords;
+
+static int
+MockDictionaryCheckHello (EnchantProviderDict *, const char *const word, size_t len)
+{
+    dictCheckCalls++;
+    if(strncmp("hello", word, len)==0)
+    {
+        return 0; //good word
+    }
+    return 1; // bad word
+}
+
+static void
+MockDictionaryCheckManyHello (EnchantProviderDict *, const char *const *words,
+                              const size_t *lens, size_t n, int *results)
+{
+    dictCheckManyCalls++;
+    dictCheckManyWords += n;
+    for(size_t i = 0; i < n; i++)
+    {
+        results[i] = strncmp("hello", words[i], lens[i])==0 ? 0 : 1;
+    }
+}
+
+static EnchantProviderDict* MockProviderRequestCheckMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestBasicMockDictionary(me, tag);
+    dict->check = MockDictionaryCheckHello;
+    return dict;
+}
+
+static EnchantProviderDict* MockProviderRequestCheckManyMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestCheckMockDictionary(me, tag);
+    dict->check_many = MockDictionaryCheckManyHello;
+    return dict;
+}
+
+static void DictionaryCheckMany_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestCheckMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
+static void DictionaryCheckManyWithProviderCheckMany_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestCheckManyMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
+struct EnchantDictionaryCheckManyTestFixtureBase : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionaryCheckManyTestFixtureBase(ConfigureHook userConfiguration):
+            EnchantDictionaryTestFixture(userConfiguration)
+    {
+        dictCheckCalls = 0;
+        dictCheckManyCalls = 0;
+        dictCheckManyWords = 0;
+    }
+};
+
+struct EnchantDictionaryCheckMany_TestFixture : EnchantDictionaryCheckManyTestFixtureBase
+{
+    //Setup
+    EnchantDictionaryCheckMany_TestFixture():
+            EnchantDictionaryCheckManyTestFixtureBase(DictionaryCheckMany_ProviderConfiguration)
+    { }
+};
+
+struct EnchantDictionaryCheckManyWithProviderCheckMany_TestFixture : EnchantDictionaryCheckManyTestFixtureBase
+{
+    //Setup
+    EnchantDictionaryCheckManyWithProviderCheckMany_TestFixture():
+            EnchantDictionaryCheckManyTestFixtureBase(DictionaryCheckManyWithProviderCheckMany_ProviderConfiguration)
+    { }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Normal Operation
+TEST_FIXTURE(EnchantDictionaryCheckMany_TestFixture,
+             EnchantDictionaryCheckMany_LenComputed)
+{
+    const char *words[] = {"hello", "helo", "hello"};
+    int results[3] = {-2, -2, -2};
+
+    enchant_dict_check_many(_dict, words, NULL, 3, results);
+    CHECK_EQUAL(0, results[0]);
+    CHECK_EQUAL(1, results[1]);
+    CHECK_EQUAL(0, results[2]);
+    CHECK_EQUAL(3, dictCheckCalls);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckMany_TestFixture,
+             EnchantDictionaryCheckMany_LenSpecified)
+{
+    const char *words[] = {"hellodisregard me", "helodisregard me", "hello"};
+    ssize_t lens[] = {5, 4, -1};
+    int results[3] = {-2, -2, -2};
+
+    enchant_dict_check_many(_dict, words, lens, 3, results);
+    CHECK_EQUAL(0, results[0]);
+    CHECK_EQUAL(1, results[1]);
+    CHECK_EQUAL(0, results[2]);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckMany_TestFixture,
+             EnchantDictionaryCheckMany_NoWords_DoesNotCallProvider)
+{
+    const char *words[] = {"hello"};
+    int results[1] = {-2};
+
+    enchant_dict_check_many(_dict, words, NULL, 0, results);
+    CHECK_EQUAL(-2, results[0]);
+    CHECK_EQUAL(0, dictCheckCalls);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckMany_TestFixture,
+             EnchantDictionaryCheckMany_SessionAndPersonal_DoNotCallProvider)
+{
+    enchant_dict_add_to_session(_dict, "session", -1);
+    enchant_dict_add(_dict, "personal", -1);
+    enchant_dict_remove(_dict, "hello", -1);
+
+    const char *words[] = {"session", "personal", "hello"};
+    int results[3] = {-2, -2, -2};
+
+    enchant_dict_check_many(_dict, words, NULL, 3, results);
+    CHECK_EQUAL(0, results[0]);
+    CHECK_EQUAL(0, results[1]);
+    CHECK_EQUAL(1, results[2]);
+    CHECK_EQUAL(0, dictCheckCalls);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckMany_TestFixture,
+             EnchantDictionaryCheckMany_HasPreviousError_ErrorCleared)
+{
+    SetErrorOnMockDictionary("something bad happened");
+
+    const char *words[] = {"hello"};
+    int results[1];
+    enchant_dict_check_many(_dict, words, NULL, 1, results);
+    CHECK_EQUAL((void*)NULL, (void*)enchant_dict_get_error(_dict));
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckManyWithProviderCheckMany_TestFixture,
+             EnchantDictionaryCheckMany_ProviderCheckMany_CalledOnceForRemainingWords)
+{
+    enchant_dict_add_to_session(_dict, "session", -1);
+
+    const char *words[] = {"hello", "session", "helo"};
+    int results[3] = {-2, -2, -2};
+
+    enchant_dict_check_many(_dict, words, NULL, 3, results);
+    CHECK_EQUAL(0, results[0]);
+    CHECK_EQUAL(0, results[1]);
+    CHECK_EQUAL(1, results[2]);
+    CHECK_EQUAL(0, dictCheckCalls);
+    CHECK_EQUAL(1, dictCheckManyCalls);
+    CHECK_EQUAL(2, dictCheckManyWords);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Error Conditions
+TEST_FIXTURE(EnchantDictionaryCheckMany_TestFixture,
+             EnchantDictionaryCheckMany_InvalidWords_Negative1)
+{
+    const char *words[] = {NULL, "", "\xa5\xf1\x08", "hello"};
+    ssize_t lens[] = {-1, -1, -1, 0};
+    int results[4] = {-2, -2, -2, -2};
+
+    enchant_dict_check_many(_dict, words, lens, 4, results);
+    CHECK_EQUAL(-1, results[0]);
+    CHECK_EQUAL(-1, results[1]);
+    CHECK_EQUAL(-1, results[2]);
+    CHECK_EQUAL(-1, results[3]);
+    CHECK_EQUAL(0, dictCheckCalls);
+}
+
+TEST_FIXTURE(EnchantDictionaryCheckMany_TestFixture,
+             EnchantDictionaryCheckMany_NullWords_DoesNotCallProvider)
+{
+    int results[1] = {-2};
+
+    enchant_dict_check_many(_dict, NULL, NULL, 1, results);
+    CHECK_EQUAL(-2, results[0]);
+    CHECK_EQUAL(0, dictCheckCalls);
+}
@@ -0,0 +1,232 @@
+/* Copyright (c) 2026 Reuben Thomas
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <enchant.h>
+#include <glib.h>
+#include "EnchantDictionaryTestFixture.h"
+
+static gint dictCheckCalls;
+static gint checksRunning;
+static gint maxChecksRunning;
+
+static int
+MockDictionaryCheckHello (EnchantProviderDict *, const char *const word, size_t len)
+{
+    g_atomic_int_inc(&dictCheckCalls);
+    if(strncmp("hello", word, len)==0)
+    {
+        return 0; //good word
+    }
+    return 1; // bad word
+}
+
+static EnchantProviderDict* MockProviderRequestCheckMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestBasicMockDictionary(me, tag);
+    dict->check = MockDictionaryCheckHello;
+    return dict;
+}
+
+static void DictionaryConcurrent_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestCheckMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
+// Record how many checks run at once, waiting a while for another to start.
+static int
+MockDictionaryCheckSlowly (EnchantProviderDict *, const char *const, size_t)
+{
+    gint running = g_atomic_int_add(&checksRunning, 1) + 1;
+    gint max;
+    while ((max = g_atomic_int_get(&maxChecksRunning)) < running &&
+           !g_atomic_int_compare_and_exchange(&maxChecksRunning, max, running))
+        ;
+    for (int i = 0; i < 50 && g_atomic_int_get(&maxChecksRunning) < 2; i++)
+        g_usleep(1000);
+    g_atomic_int_add(&checksRunning, -1);
+    return 1;
+}
+
+static EnchantProviderDict* MockProviderRequestSlowMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestBasicMockDictionary(me, tag);
+    dict->check = MockDictionaryCheckSlowly;
+    return dict;
+}
+
+static void DictionarySlow_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestSlowMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
+static void DictionarySlowSerialized_ProviderConfiguration (EnchantProvider * me)
+{
+     DictionarySlow_ProviderConfiguration(me);
+     me->serialize_dict_calls = 1;
+}
+
+struct EnchantDictionaryConcurrent_TestFixture : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionaryConcurrent_TestFixture():
+            EnchantDictionaryTestFixture(DictionaryConcurrent_ProviderConfiguration)
+    {
+        dictCheckCalls = 0;
+        enchant_dict_set_concurrent(_dict, 1);
+    }
+};
+
+struct EnchantDictionaryConcurrentSlow_TestFixture : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionaryConcurrentSlow_TestFixture(ConfigureHook userConfiguration = DictionarySlow_ProviderConfiguration):
+            EnchantDictionaryTestFixture(userConfiguration)
+    {
+        checksRunning = 0;
+        maxChecksRunning = 0;
+        enchant_dict_set_concurrent(_dict, 1);
+    }
+};
+
+struct EnchantDictionaryConcurrentSlowSerialized_TestFixture : EnchantDictionaryConcurrentSlow_TestFixture
+{
+    //Setup
+    EnchantDictionaryConcurrentSlowSerialized_TestFixture():
+            EnchantDictionaryConcurrentSlow_TestFixture(DictionarySlowSerialized_ProviderConfiguration)
+    { }
+};
+
+static const int checksPerThread = 1000;
+
+static gpointer
+CheckWords (gpointer data)
+{
+    EnchantDict *dict = static_cast<EnchantDict *>(data);
+    int failures = 0;
+    for (int i = 0; i < checksPerThread; i++)
+    {
+        if (enchant_dict_check(dict, "hello", -1) != 0)
+            failures++;
+        if (enchant_dict_check(dict, "helo", -1) != 1)
+            failures++;
+    }
+    return GINT_TO_POINTER(failures);
+}
+
+static gpointer
+AddWords (gpointer data)
+{
+    EnchantDict *dict = static_cast<EnchantDict *>(data);
+    for (int i = 0; i < checksPerThread; i++)
+    {
+        char word[32];
+        sprintf(word, "word%d", i);
+        enchant_dict_add_to_session(dict, word, -1);
+    }
+    return NULL;
+}
+
+static gpointer
+CheckTwoWords (gpointer data)
+{
+    EnchantDict *dict = static_cast<EnchantDict *>(data);
+    enchant_dict_check(dict, "helo", -1);
+    enchant_dict_check(dict, "wrold", -1);
+    return NULL;
+}
+
+static gpointer
+GetError (gpointer data)
+{
+    EnchantDict *dict = static_cast<EnchantDict *>(data);
+    return const_cast<char *>(enchant_dict_get_error(dict));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Normal Operation
+TEST_FIXTURE(EnchantDictionaryConcurrent_TestFixture,
+             EnchantDictionaryConcurrent_ChecksFromSeveralThreads_Consistent)
+{
+    const int nThreads = 4;
+    GThread *threads[nThreads];
+    for (int i = 0; i < nThreads; i++)
+        threads[i] = g_thread_new(NULL, CheckWords, _dict);
+    GThread *writer = g_thread_new(NULL, AddWords, _dict);
+
+    for (int i = 0; i < nThreads; i++)
+        CHECK_EQUAL(0, GPOINTER_TO_INT(g_thread_join(threads[i])));
+    g_thread_join(writer);
+
+    CHECK_EQUAL(2 * nThreads * checksPerThread, dictCheckCalls);
+    CHECK_EQUAL(1, enchant_dict_is_added(_dict, "word999", -1));
+}
+
+TEST_FIXTURE(EnchantDictionaryConcurrent_TestFixture,
+             EnchantDictionaryConcurrent_Error_OnlySeenByItsThread)
+{
+    SetErrorOnMockDictionary("something bad happened");
+
+    GThread *thread = g_thread_new(NULL, GetError, _dict);
+    CHECK_EQUAL((void*)NULL, g_thread_join(thread));
+    CHECK_EQUAL("something bad happened", enchant_dict_get_error(_dict));
+}
+
+TEST_FIXTURE(EnchantDictionaryConcurrentSlow_TestFixture,
+             EnchantDictionaryConcurrent_ProviderCallsRunInParallel)
+{
+    GThread *first = g_thread_new(NULL, CheckTwoWords, _dict);
+    GThread *second = g_thread_new(NULL, CheckTwoWords, _dict);
+    g_thread_join(first);
+    g_thread_join(second);
+
+    CHECK_EQUAL(2, maxChecksRunning);
+}
+
+TEST_FIXTURE(EnchantDictionaryConcurrentSlowSerialized_TestFixture,
+             EnchantDictionaryConcurrent_ProviderRequiresSerialization_CallsRunInTurn)
+{
+    GThread *first = g_thread_new(NULL, CheckTwoWords, _dict);
+    GThread *second = g_thread_new(NULL, CheckTwoWords, _dict);
+    g_thread_join(first);
+    g_thread_join(second);
+
+    CHECK_EQUAL(1, maxChecksRunning);
+}
+
+TEST_FIXTURE(EnchantDictionaryConcurrentSlowSerialized_TestFixture,
+             EnchantDictionaryConcurrent_SharedProviderRequiresSerialization_CallsRunInTurn)
+{
+    // Neither dictionary is in concurrent mode, but they share a provider dictionary
+    enchant_broker_set_share_dicts(_broker, 1);
+    EnchantDict *dict1 = enchant_broker_request_dict(_broker, "qaa");
+    EnchantDict *dict2 = enchant_broker_request_dict(_broker, "qaa");
+    GThread *first = g_thread_new(NULL, CheckTwoWords, dict1);
+    GThread *second = g_thread_new(NULL, CheckTwoWords, dict2);
+    g_thread_join(first);
+    g_thread_join(second);
+
+    CHECK_EQUAL(1, maxChecksRunning);
+    enchant_broker_free_dict(_broker, dict1);
+    enchant_broker_free_dict(_broker, dict2);
+}
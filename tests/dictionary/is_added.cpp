@@ -72,6 +72,19 @@ TEST_FIXTURE(EnchantDictionaryIsAdded_TestFixture,
     CHECK_EQUAL(0, enchant_dict_is_added(_pwl, "hello", -1));
 }
 
+TEST_FIXTURE(EnchantDictionaryIsAdded_TestFixture, 
+             EnchantDictionaryIsAdded_InPwlButRemovedFromSession_1)
+{
+    ExternalAddWordToDictionary("hello");
+    ReloadTestDictionary();
+
+    enchant_dict_remove_from_session(_dict, "hello", -1);
+
+    CHECK_EQUAL(1, enchant_dict_is_added(_dict, "hello", -1));
+    CHECK_EQUAL(1, enchant_dict_is_removed(_dict, "hello", -1));
+    CHECK_EQUAL(1, enchant_dict_check(_dict, "hello", -1));
+}
+
 TEST_FIXTURE(EnchantDictionaryIsAdded_TestFixture, 
              EnchantDictionaryIsAdded_HasPreviousError_ErrorCleared)
 {
@@ -115,5 +128,7 @@ TEST_FIXTURE(EnchantDictionaryIsAdded_TestFixture,
 
 	ReloadTestDictionary();
 	CHECK_EQUAL(0, enchant_dict_is_added(_dict, "hello", -1));
+	// The word lists are only read once, so asking again gives the same answer
+	CHECK_EQUAL(0, enchant_dict_is_added(_dict, "hello", -1));
 }
 
@@ -83,7 +83,7 @@ TEST_FIXTURE(EnchantDictionaryRemoveFromSession_TestFixture,
     enchant_dict_remove_from_session(_dict, "aelo", -1);
 
     std::vector<std::string> suggestions = GetSuggestions("helo");
-    CHECK_EQUAL(3 * (std::count(languageTag.begin(), languageTag.end(), ',') + 1), suggestions.size());
+    CHECK_EQUAL(3, suggestions.size());
     CHECK_ARRAY_EQUAL(GetExpectedSuggestions("helo",1), suggestions, 3);
 }
 
@@ -94,7 +94,7 @@ TEST_FIXTURE(EnchantDictionaryRemoveFromSession_TestFixture,
     enchant_dict_add_to_session(_dict, "aelo", -1);
 
     std::vector<std::string> suggestions = GetSuggestions("helo");
-    CHECK_EQUAL(4 * (std::count(languageTag.begin(), languageTag.end(), ',') + 1), suggestions.size());
+    CHECK_EQUAL(4, suggestions.size());
     CHECK_ARRAY_EQUAL(GetExpectedSuggestions("helo"), suggestions, 4);
 }
 
@@ -0,0 +1,143 @@
+/* Copyright (c) 2026 Reuben Thomas
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <enchant.h>
+#include "EnchantDictionaryTestFixture.h"
+
+static int
+MockDictionaryCheckHello (EnchantProviderDict *, const char *const word, size_t len)
+{
+    if(strncmp("hello", word, len)==0)
+    {
+        return 0; //good word
+    }
+    return 1; // bad word
+}
+
+static EnchantProviderDict* MockProviderRequestCheckMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestBasicMockDictionary(me, tag);
+    dict->check = MockDictionaryCheckHello;
+    return dict;
+}
+
+static void DictionaryRemoveMany_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestCheckMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
+struct EnchantDictionaryRemoveMany_TestFixture : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionaryRemoveMany_TestFixture():
+            EnchantDictionaryTestFixture(DictionaryRemoveMany_ProviderConfiguration)
+    { }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Normal Operation
+TEST_FIXTURE(EnchantDictionaryRemoveMany_TestFixture,
+             EnchantDictionaryRemoveMany_WordsNoLongerExistInDictionary)
+{
+    enchant_dict_add(_dict, "world", -1);
+    CHECK(IsWordInDictionary("hello"));
+    CHECK(IsWordInDictionary("world"));
+
+    const char *words[] = {"hello", "world"};
+    enchant_dict_remove_many(_dict, words, NULL, 2);
+
+    CHECK(!IsWordInDictionary("hello"));
+    CHECK(!IsWordInDictionary("world"));
+    CHECK(!IsWordInSession("hello"));
+    CHECK(!IsWordInSession("world"));
+}
+
+TEST_FIXTURE(EnchantDictionaryRemoveMany_TestFixture,
+             EnchantDictionaryRemoveMany_WordsAddedToExcludeFile)
+{
+    CHECK(!ExcludeFileHasContents());
+
+    const char *words[] = {"hello", "world"};
+    enchant_dict_remove_many(_dict, words, NULL, 2);
+
+    CHECK(ExcludeFileHasContents());
+    ReloadTestDictionary();
+    CHECK(!IsWordInDictionary("hello"));
+}
+
+TEST_FIXTURE(EnchantDictionaryRemoveMany_TestFixture,
+             EnchantDictionaryRemoveMany_WordsRemovedFromPwlFile)
+{
+    const char *words[] = {"hello", "world"};
+    enchant_dict_add_many(_dict, words, NULL, 2);
+    CHECK(PersonalWordListFileHasContents());
+
+    enchant_dict_remove_many(_dict, words, NULL, 2);
+
+    CHECK(!PersonalWordListFileHasContents());
+}
+
+TEST_FIXTURE(EnchantDictionaryRemoveMany_TestFixture,
+             EnchantDictionaryRemoveMany_OtherWordsKept)
+{
+    const char *words[] = {"hello", "world", "personal"};
+    enchant_dict_add_many(_dict, words, NULL, 3);
+
+    enchant_dict_remove_many(_dict, words, NULL, 2);
+    ReloadTestDictionary();
+
+    CHECK(!IsWordInDictionary("hello"));
+    CHECK(!IsWordInDictionary("world"));
+    CHECK(IsWordInDictionary("personal"));
+}
+
+TEST_FIXTURE(EnchantDictionaryRemoveMany_TestFixture,
+             EnchantDictionaryRemoveMany_LensUsed)
+{
+    const char *words[] = {"helloworld"};
+    ssize_t lens[] = {5};
+    enchant_dict_remove_many(_dict, words, lens, 1);
+
+    CHECK(!IsWordInDictionary("hello"));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Error Conditions
+TEST_FIXTURE(EnchantDictionaryRemoveMany_TestFixture,
+             EnchantDictionaryRemoveMany_NullWordsIgnored)
+{
+    const char *words[] = {NULL, "hello", ""};
+    enchant_dict_remove_many(_dict, words, NULL, 3);
+
+    CHECK(!IsWordInDictionary("hello"));
+}
+
+TEST_FIXTURE(EnchantDictionaryRemoveMany_TestFixture,
+             EnchantDictionaryRemoveMany_NoWords_NothingWritten)
+{
+    const char *words[] = {"hello"};
+    enchant_dict_remove_many(_dict, words, NULL, 0);
+
+    CHECK(!ExcludeFileHasContents());
+    CHECK(IsWordInDictionary("hello"));
+}
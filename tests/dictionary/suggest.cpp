@@ -131,3 +131,41 @@ struct EnchantDictionarySuggest_TestFixture_qaaqaa : EnchantDictionarySuggestTes
 #undef EnchantDictionarySuggest_TestFixture
 #define EnchantDictionarySuggest_TestFixture EnchantDictionarySuggest_TestFixture_qaaqaa
 #include "suggest.i"
+
+/////////////////////////////////////////////////////////////////////////////
+// Parallel composite dictionaries
+
+struct EnchantDictionarySuggest_TestFixture_qaaqaa_parallel : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionarySuggest_TestFixture_qaaqaa_parallel():
+            EnchantDictionaryTestFixture(EmptyDictionary_ProviderConfiguration, "qaa,qaa")
+    {
+        enchant_dict_set_parallel(_dict, 1);
+        _suggestions = NULL;
+    }
+    //Teardown
+    ~EnchantDictionarySuggest_TestFixture_qaaqaa_parallel()
+    {
+        FreeStringList(_suggestions);
+    }
+
+    char** _suggestions;
+};
+
+TEST_FIXTURE(EnchantDictionarySuggest_TestFixture_qaaqaa_parallel,
+             EnchantDictionarySuggest_Parallel_SuggestionsMergedInChildOrder)
+{
+    size_t cSuggestions;
+    _suggestions = enchant_dict_suggest(_dict, "helo", -1, &cSuggestions);
+    CHECK(_suggestions);
+
+    std::vector<std::string> suggestions;
+    if(_suggestions != NULL){
+        suggestions.insert(suggestions.begin(), _suggestions, _suggestions+cSuggestions);
+    }
+
+    std::vector<std::string> expected = GetExpectedSuggestions("helo");
+    CHECK_EQUAL(expected.size(), cSuggestions);
+    CHECK_ARRAY_EQUAL(expected, suggestions, std::min(expected.size(), suggestions.size()));
+}
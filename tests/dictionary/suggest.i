@@ -32,7 +32,7 @@ TEST_FIXTURE(EnchantDictionarySuggest_TestFixture,
     _suggestions = enchant_dict_suggest(_dict, "helo", -1, &cSuggestions);
     CHECK(_suggestions);
     CHECK_EQUAL(std::string("helo"), suggestWord);
-    CHECK_EQUAL(4 * (std::count(languageTag.begin(), languageTag.end(), ',') + 1), cSuggestions);
+    CHECK_EQUAL(4, cSuggestions);
 
     std::vector<std::string> suggestions;
     if(_suggestions != NULL){
@@ -49,7 +49,7 @@ TEST_FIXTURE(EnchantDictionarySuggest_TestFixture,
     _suggestions = enchant_dict_suggest(_dict, "helodisregard me", 4, &cSuggestions);
     CHECK(_suggestions);
     CHECK_EQUAL(std::string("helo"), suggestWord);
-    CHECK_EQUAL(4 * (std::count(languageTag.begin(), languageTag.end(), ',') + 1), cSuggestions);
+    CHECK_EQUAL(4, cSuggestions);
 
     std::vector<std::string> suggestions;
     if(_suggestions != NULL){
@@ -83,7 +83,7 @@ TEST_FIXTURE(EnchantDictionarySuggest_TestFixture,
     enchant_dict_add(_dict, "aelo", -1);
     _suggestions = enchant_dict_suggest(_dict, "helo", -1, &cSuggestions);
     CHECK(_suggestions);
-    CHECK_EQUAL(4 * (std::count(languageTag.begin(), languageTag.end(), ',') + 1), cSuggestions);
+    CHECK_EQUAL(4, cSuggestions);
 
     std::vector<std::string> suggestions;
     if(_suggestions != NULL){
@@ -104,6 +104,24 @@ TEST_FIXTURE(EnchantDictionarySuggest_TestFixture,
     CHECK_EQUAL(cSuggestions, 0);
 }
 
+TEST_FIXTURE(EnchantDictionarySuggest_TestFixture,
+             EnchantDictionarySuggest_MaxSuggestions_Limited)
+{
+    enchant_dict_set_max_suggestions(_dict, 2);
+
+    size_t cSuggestions;
+    _suggestions = enchant_dict_suggest(_dict, "helo", -1, &cSuggestions);
+    CHECK(_suggestions);
+    CHECK_EQUAL(2, cSuggestions);
+
+    std::vector<std::string> suggestions;
+    if(_suggestions != NULL){
+        suggestions.insert(suggestions.begin(), _suggestions, _suggestions+cSuggestions);
+    }
+
+    CHECK_ARRAY_EQUAL(GetExpectedSuggestions("helo"), suggestions, std::min((size_t)2,cSuggestions));
+}
+
 TEST_FIXTURE(EnchantDictionarySuggest_TestFixture, 
              EnchantDictionarySuggest_HasPreviousError_ErrorCleared)
 {
@@ -161,7 +179,7 @@ TEST_FIXTURE(EnchantDictionarySuggest_TestFixture,
     CHECK(_suggestions);
     CHECK(dictSuggestCalled);
 
-    CHECK_EQUAL(3 * (std::count(languageTag.begin(), languageTag.end(), ',') + 1), cSuggestions);
+    CHECK_EQUAL(3, cSuggestions);
 
     std::vector<std::string> suggestions;
     if(_suggestions != NULL){
@@ -184,6 +202,6 @@ TEST_FIXTURE(EnchantDictionarySuggest_TestFixture,
     _suggestions = enchant_dict_suggest(_dict, "fiance", -1, &cSuggestions);
     CHECK(_suggestions);
 
-    CHECK_EQUAL(1 * (std::count(languageTag.begin(), languageTag.end(), ',') + 1), cSuggestions);
+    CHECK_EQUAL(1, cSuggestions);
     CHECK_EQUAL(Convert(L"fianc\xe9"), _suggestions[0]);
 }
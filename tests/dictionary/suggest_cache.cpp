@@ -0,0 +1,134 @@
+/* Copyright (c) 2026 Reuben Thomas
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <enchant.h>
+#include <vector>
+
+#include "EnchantDictionaryTestFixture.h"
+
+static int dictSuggestCalls;
+
+static char **
+MyMockDictionarySuggest (EnchantProviderDict * dict, const char *const word, size_t len, size_t * out_n_suggs)
+{
+    dictSuggestCalls++;
+    return MockDictionarySuggest(dict, word, len, out_n_suggs);
+}
+
+static EnchantProviderDict* MockProviderRequestSuggestMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestBasicMockDictionary(me, tag);
+    dict->suggest = MyMockDictionarySuggest;
+    return dict;
+}
+
+static void DictionarySuggestCache_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestSuggestMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
+struct EnchantDictionarySuggestCache_TestFixture : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionarySuggestCache_TestFixture():
+            EnchantDictionaryTestFixture(DictionarySuggestCache_ProviderConfiguration)
+    {
+        dictSuggestCalls = 0;
+        enchant_dict_set_suggest_cache_size(_dict, 4096);
+    }
+
+    void CheckStats(size_t expectedHits, size_t expectedMisses)
+    {
+        size_t hits, misses;
+        enchant_dict_get_suggest_cache_stats(_dict, &hits, &misses);
+        CHECK_EQUAL(expectedHits, hits);
+        CHECK_EQUAL(expectedMisses, misses);
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Normal Operation
+TEST_FIXTURE(EnchantDictionarySuggestCache_TestFixture,
+             EnchantDictionarySuggestCache_RepeatedWord_CallsProviderOnce)
+{
+    std::vector<std::string> first = GetSuggestionsFromWord("helo");
+    std::vector<std::string> second = GetSuggestionsFromWord("helo");
+    CHECK_EQUAL(1, dictSuggestCalls);
+    CHECK_EQUAL(4, second.size());
+    CHECK_ARRAY_EQUAL(first, second, first.size());
+    CheckStats(1, 1);
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestCache_TestFixture,
+             EnchantDictionarySuggestCache_SuggestMany_UsesCache)
+{
+    GetSuggestionsFromWord("helo");
+
+    const char *words[] = {"helo"};
+    size_t n_suggs[1];
+    char ***suggestions = enchant_dict_suggest_many(_dict, words, NULL, 1, n_suggs);
+    CHECK_EQUAL(1, dictSuggestCalls);
+    CHECK_EQUAL(4, n_suggs[0]);
+    enchant_dict_free_string_lists(_dict, suggestions);
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestCache_TestFixture,
+             EnchantDictionarySuggestCache_Remove_SuggestionExcluded)
+{
+    GetSuggestionsFromWord("helo");
+    RemoveWordFromDictionary("belo");
+
+    std::vector<std::string> suggestions = GetSuggestionsFromWord("helo");
+    CHECK_EQUAL(2, dictSuggestCalls);
+    CHECK_EQUAL(3, suggestions.size());
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestCache_TestFixture,
+             EnchantDictionarySuggestCache_ExternalExclude_SuggestionExcluded)
+{
+    GetSuggestionsFromWord("helo");
+    ExternalAddWordToExclude("belo");
+
+    std::vector<std::string> suggestions = GetSuggestionsFromWord("helo");
+    CHECK_EQUAL(2, dictSuggestCalls);
+    CHECK_EQUAL(3, suggestions.size());
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestCache_TestFixture,
+             EnchantDictionarySuggestCache_TooSmall_NotCached)
+{
+    enchant_dict_set_suggest_cache_size(_dict, 1);
+    GetSuggestionsFromWord("helo");
+    GetSuggestionsFromWord("helo");
+    CHECK_EQUAL(2, dictSuggestCalls);
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestCache_TestFixture,
+             EnchantDictionarySuggestCache_Disabled_NoStats)
+{
+    enchant_dict_set_suggest_cache_size(_dict, 0);
+    GetSuggestionsFromWord("helo");
+    GetSuggestionsFromWord("helo");
+    CHECK_EQUAL(2, dictSuggestCalls);
+    CheckStats(0, 0);
+}
@@ -0,0 +1,195 @@
+/* Copyright (c) 2026 Reuben Thomas
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+#include <enchant.h>
+#include <vector>
+
+#include "EnchantDictionaryTestFixture.h"
+
+static int dictSuggestCalls;
+
+static char **
+MyMockDictionarySuggest (EnchantProviderDict * dict, const char *const word, size_t len, size_t * out_n_suggs)
+{
+    dictSuggestCalls++;
+    if(strncmp("null", word, len)==0)
+    {
+        *out_n_suggs = 0;
+        return NULL;
+    }
+    return MockDictionarySuggest(dict, word, len, out_n_suggs);
+}
+
+static EnchantProviderDict* MockProviderRequestSuggestMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestBasicMockDictionary(me, tag);
+    dict->suggest = MyMockDictionarySuggest;
+    return dict;
+}
+
+static void DictionarySuggestMany_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestSuggestMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
+struct EnchantDictionarySuggestMany_TestFixture : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantDictionarySuggestMany_TestFixture():
+            EnchantDictionaryTestFixture(DictionarySuggestMany_ProviderConfiguration)
+    {
+        dictSuggestCalls = 0;
+        _suggestions = NULL;
+    }
+
+    //Teardown
+    ~EnchantDictionarySuggestMany_TestFixture()
+    {
+        if(_suggestions)
+        {
+            enchant_dict_free_string_lists(_dict, _suggestions);
+        }
+    }
+
+    std::vector<std::string> GetList(size_t i, size_t n)
+    {
+        std::vector<std::string> result;
+        if(_suggestions[i] != NULL){
+            result.insert(result.begin(), _suggestions[i], _suggestions[i]+n);
+        }
+        return result;
+    }
+
+    char*** _suggestions;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Normal Operation
+TEST_FIXTURE(EnchantDictionarySuggestMany_TestFixture,
+             EnchantDictionarySuggestMany_LenComputed)
+{
+    const char *words[] = {"helo", "wrld"};
+    size_t n_suggs[2];
+
+    _suggestions = enchant_dict_suggest_many(_dict, words, NULL, 2, n_suggs);
+    CHECK(_suggestions);
+    CHECK_EQUAL(2, dictSuggestCalls);
+    CHECK_EQUAL(4, n_suggs[0]);
+    CHECK_EQUAL(4, n_suggs[1]);
+
+    std::vector<std::string> expected = GetExpectedSuggestions("helo");
+    CHECK_ARRAY_EQUAL(expected, GetList(0, n_suggs[0]), expected.size());
+    CHECK_EQUAL((void*)NULL, (void*)_suggestions[0][n_suggs[0]]);
+
+    expected = GetExpectedSuggestions("wrld");
+    CHECK_ARRAY_EQUAL(expected, GetList(1, n_suggs[1]), expected.size());
+    CHECK_EQUAL((void*)NULL, (void*)_suggestions[1][n_suggs[1]]);
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestMany_TestFixture,
+             EnchantDictionarySuggestMany_LenSpecified)
+{
+    const char *words[] = {"helodisregard me", "wrld"};
+    ssize_t lens[] = {4, -1};
+    size_t n_suggs[2];
+
+    _suggestions = enchant_dict_suggest_many(_dict, words, lens, 2, n_suggs);
+    CHECK(_suggestions);
+
+    std::vector<std::string> expected = GetExpectedSuggestions("helo");
+    CHECK_ARRAY_EQUAL(expected, GetList(0, n_suggs[0]), expected.size());
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestMany_TestFixture,
+             EnchantDictionarySuggestMany_NullOutNSuggs)
+{
+    const char *words[] = {"helo"};
+
+    _suggestions = enchant_dict_suggest_many(_dict, words, NULL, 1, NULL);
+    CHECK(_suggestions);
+    CHECK_EQUAL(std::string("aelo"), std::string(_suggestions[0][0]));
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestMany_TestFixture,
+             EnchantDictionarySuggestMany_ExcludedSuggestionsRemoved)
+{
+    enchant_dict_remove(_dict, "belo", -1);
+    const char *words[] = {"helo"};
+    size_t n_suggs[1];
+
+    _suggestions = enchant_dict_suggest_many(_dict, words, NULL, 1, n_suggs);
+    CHECK(_suggestions);
+    CHECK_EQUAL(3, n_suggs[0]);
+
+    std::vector<std::string> expected;
+    expected.push_back("aelo");
+    expected.push_back("celo");
+    expected.push_back("delo");
+    CHECK_ARRAY_EQUAL(expected, GetList(0, n_suggs[0]), expected.size());
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestMany_TestFixture,
+             EnchantDictionarySuggestMany_HasPreviousError_ErrorCleared)
+{
+    SetErrorOnMockDictionary("something bad happened");
+
+    const char *words[] = {"helo"};
+    _suggestions = enchant_dict_suggest_many(_dict, words, NULL, 1, NULL);
+    CHECK_EQUAL((void*)NULL, (void*)enchant_dict_get_error(_dict));
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestMany_TestFixture,
+             EnchantDictionarySuggestMany_NoWords_EmptyNonNullResult)
+{
+    const char *words[] = {"helo"};
+    _suggestions = enchant_dict_suggest_many(_dict, words, NULL, 0, NULL);
+    CHECK(_suggestions);
+    CHECK_EQUAL(0, dictSuggestCalls);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Error Conditions
+TEST_FIXTURE(EnchantDictionarySuggestMany_TestFixture,
+             EnchantDictionarySuggestMany_InvalidWords_NullList)
+{
+    const char *words[] = {NULL, "", "\xa5\xf1\x08", "null", "helo"};
+    size_t n_suggs[5];
+
+    _suggestions = enchant_dict_suggest_many(_dict, words, NULL, 5, n_suggs);
+    CHECK(_suggestions);
+    CHECK_EQUAL(2, dictSuggestCalls);
+    for(size_t i = 0; i < 4; i++)
+    {
+        CHECK_EQUAL((void*)NULL, (void*)_suggestions[i]);
+        CHECK_EQUAL(0, n_suggs[i]);
+    }
+    CHECK_EQUAL(4, n_suggs[4]);
+}
+
+TEST_FIXTURE(EnchantDictionarySuggestMany_TestFixture,
+             EnchantDictionarySuggestMany_NullWords_NullSuggestions)
+{
+    _suggestions = enchant_dict_suggest_many(_dict, NULL, NULL, 1, NULL);
+    CHECK_EQUAL((void*)NULL, (void*)_suggestions);
+    CHECK_EQUAL(0, dictSuggestCalls);
+}
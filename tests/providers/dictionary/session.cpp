@@ -0,0 +1,222 @@
+/* Copyright (c) 2026 Reuben Thomas
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <UnitTest++/UnitTest++.h>
+
+#include "../unittest_enchant_providers.h"
+#include <string>
+#include <string.h>
+#include <glib/gstdio.h>
+#include <utime.h>
+
+struct DictionarySession_TestFixture : Provider_TestFixture
+{
+    EnchantProviderDict* _dict;
+    EnchantProviderDict* _otherDict;
+
+    //Setup
+    DictionarySession_TestFixture():_dict(NULL), _otherDict(NULL)
+    { 
+        /* FIXME: hspell does not consider non-Hebrew letters to be valid letters */
+        if (strcmp(_provider->identify(_provider), "hspell") != 0) {
+            _dict = GetDefaultDictionary();
+            _otherDict = GetDefaultDictionary();
+        }
+    }
+
+    //Teardown
+    ~DictionarySession_TestFixture()
+    {
+        ReleaseDictionary(_dict);
+        ReleaseDictionary(_otherDict);
+    }
+
+    static bool IsWordInDictionary(EnchantProviderDict* dict, const std::string& word)
+    {
+        return (*dict->check)(dict, word.c_str(), word.length()) == 0;
+    }
+};
+
+// add_to_session is optional
+
+/////////////////////////////////////////////////////////////////////////////
+// Test Normal Operation
+
+TEST_FIXTURE(DictionarySession_TestFixture,
+             AddToSession_TwoHandlesForSameDictionary_WordOnlyInOneSession)
+{
+    if (_dict && _otherDict && _dict->check && _otherDict->check && _dict->add_to_session)
+    {
+        std::string word("qzxzqzxq");
+        (*_dict->add_to_session)(_dict, word.c_str(), word.length());
+
+        CHECK(IsWordInDictionary(_dict, word));
+        CHECK(!IsWordInDictionary(_otherDict, word));
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// If ENCHANT_SHARE_DICTS is set, Hunspell keeps a parsed dictionary for
+// handles requested later
+
+struct HunspellDictionaryReuse_TestFixture : Provider_TestFixture
+{
+    std::string _dicFile;
+    std::string _affFile;
+
+    //Setup
+    HunspellDictionaryReuse_TestFixture()
+    {
+        if (strcmp(_provider->identify(_provider), "hunspell") != 0)
+            return;
+
+        char* dir = enchant_provider_get_user_dict_dir(_provider);
+        g_mkdir_with_parents(dir, 0700);
+        char* dic = g_build_filename(dir, "qaa.dic", nullptr);
+        char* aff = g_build_filename(dir, "qaa.aff", nullptr);
+        _dicFile = dic;
+        _affFile = aff;
+        g_free(dic);
+        g_free(aff);
+        g_free(dir);
+
+        g_file_set_contents(_affFile.c_str(), "SET UTF-8\n", -1, NULL);
+        g_file_set_contents(_dicFile.c_str(), "1\ncat\n", -1, NULL);
+        g_setenv("ENCHANT_SHARE_DICTS", "1", TRUE);
+    }
+
+    //Teardown
+    ~HunspellDictionaryReuse_TestFixture()
+    {
+        g_unsetenv("ENCHANT_SHARE_DICTS");
+        if (!_dicFile.empty()) {
+            g_remove(_dicFile.c_str());
+            g_remove(_affFile.c_str());
+        }
+    }
+
+    // Change the words, but not the size or the modification time
+    void ReplaceWordsUnnoticed(const char* contents)
+    {
+        GStatBuf st;
+        g_stat(_dicFile.c_str(), &st);
+        g_file_set_contents(_dicFile.c_str(), contents, -1, NULL);
+        struct utimbuf times;
+        times.actime = st.st_atime;
+        times.modtime = st.st_mtime;
+        g_utime(_dicFile.c_str(), &times);
+    }
+
+    static bool IsWordInDictionary(EnchantProviderDict* dict, const std::string& word)
+    {
+        return (*dict->check)(dict, word.c_str(), word.length()) == 0;
+    }
+};
+
+TEST_FIXTURE(HunspellDictionaryReuse_TestFixture,
+             RequestDictionary_SameTagAfterSessionChanges_ReusesLoadedDictionary)
+{
+    if (_dicFile.empty())
+        return;
+
+    EnchantProviderDict* dict = GetDictionary("qaa");
+    CHECK(dict);
+    if (!dict)
+        return;
+    (*dict->add_to_session)(dict, "bird", 4);
+    (*dict->remove_from_session)(dict, "cat", 3);
+    ReleaseDictionary(dict);
+
+    // A dictionary parsed again would have "dog" rather than "cat"
+    ReplaceWordsUnnoticed("1\ndog\n");
+    dict = GetDictionary("qaa");
+    CHECK(dict);
+    if (!dict)
+        return;
+    CHECK(IsWordInDictionary(dict, "cat"));
+    CHECK(!IsWordInDictionary(dict, "dog"));
+    CHECK(!IsWordInDictionary(dict, "bird"));
+    ReleaseDictionary(dict);
+}
+
+TEST_FIXTURE(HunspellDictionaryReuse_TestFixture,
+             RequestDictionary_FilesChanged_LoadsDictionaryAgain)
+{
+    if (_dicFile.empty())
+        return;
+
+    EnchantProviderDict* dict = GetDictionary("qaa");
+    CHECK(dict);
+    if (!dict)
+        return;
+    ReleaseDictionary(dict);
+
+    g_file_set_contents(_dicFile.c_str(), "2\ncat\nhorse\n", -1, NULL);
+    dict = GetDictionary("qaa");
+    CHECK(dict);
+    if (!dict)
+        return;
+    CHECK(IsWordInDictionary(dict, "horse"));
+    ReleaseDictionary(dict);
+}
+
+TEST_FIXTURE(HunspellDictionaryReuse_TestFixture,
+             RequestDictionary_NotShared_LoadsDictionaryAgain)
+{
+    if (_dicFile.empty())
+        return;
+
+    g_unsetenv("ENCHANT_SHARE_DICTS");
+    EnchantProviderDict* dict = GetDictionary("qaa");
+    CHECK(dict);
+    if (!dict)
+        return;
+    ReleaseDictionary(dict);
+
+    ReplaceWordsUnnoticed("1\ndog\n");
+    dict = GetDictionary("qaa");
+    CHECK(dict);
+    if (!dict)
+        return;
+    CHECK(IsWordInDictionary(dict, "dog"));
+    ReleaseDictionary(dict);
+}
+
+TEST_FIXTURE(HunspellDictionaryReuse_TestFixture,
+             AddToSession_Shared_OtherHandleUnaffected)
+{
+    if (_dicFile.empty())
+        return;
+
+    EnchantProviderDict* dict = GetDictionary("qaa");
+    EnchantProviderDict* otherDict = GetDictionary("qaa");
+    CHECK(dict && otherDict);
+    if (dict && otherDict) {
+        (*dict->add_to_session)(dict, "bird", 4);
+        (*dict->remove_from_session)(dict, "cat", 3);
+        CHECK(IsWordInDictionary(dict, "bird"));
+        CHECK(!IsWordInDictionary(dict, "cat"));
+        CHECK(!IsWordInDictionary(otherDict, "bird"));
+        CHECK(IsWordInDictionary(otherDict, "cat"));
+    }
+    ReleaseDictionary(dict);
+    ReleaseDictionary(otherDict);
+}
@@ -20,6 +20,7 @@
  */
 
 #include <unistd.h>
+#include <utime.h>
 #include <UnitTest++/UnitTest++.h>
 #include <stdio.h>
 #include <enchant.h>
@@ -54,6 +55,37 @@ static void DictionarySuggest_ProviderConfiguration (EnchantProvider * me)
      me->dispose_dict = MockProviderDisposeDictionary;
 }
 
+static std::vector<std::string> providerSession;
+
+static void
+DictionaryAddToSession (EnchantProviderDict *, const char *const word, size_t len)
+{
+    providerSession.push_back(std::string(word, len));
+}
+
+static void
+DictionaryRemoveFromSession (EnchantProviderDict *, const char *const word, size_t len)
+{
+    std::vector<std::string>::iterator it =
+        std::find(providerSession.begin(), providerSession.end(), std::string(word, len));
+    if (it != providerSession.end())
+        providerSession.erase(it);
+}
+
+static EnchantProviderDict* MockProviderRequestSessionMockDictionary(EnchantProvider * me, const char *tag)
+{
+    EnchantProviderDict* dict = MockProviderRequestSuggestMockDictionary(me, tag);
+    dict->add_to_session = DictionaryAddToSession;
+    dict->remove_from_session = DictionaryRemoveFromSession;
+    return dict;
+}
+
+static void DictionarySession_ProviderConfiguration (EnchantProvider * me)
+{
+     me->request_dict = MockProviderRequestSessionMockDictionary;
+     me->dispose_dict = MockProviderDisposeDictionary;
+}
+
 
 struct EnchantPwlWithDictSuggs_TestFixture_qaa : EnchantDictionaryTestFixture
 {
@@ -85,6 +117,59 @@ struct EnchantPwl_TestFixture_qaaqaa : EnchantDictionaryTestFixture
     { }
 };
 
+struct EnchantPwlWithDictSuggs_TestFixture_qaa_index : EnchantPwlWithDictSuggs_TestFixture_qaa
+{
+    EnchantPwlWithDictSuggs_TestFixture_qaa_index()
+    {
+        enchant_dict_set_pwl_index(_dict, 1);
+    }
+};
+
+struct EnchantPwl_TestFixture_qaa_index : EnchantPwl_TestFixture_qaa
+{
+    //Setup
+    EnchantPwl_TestFixture_qaa_index()
+    {
+        enchant_dict_set_pwl_index(_dict, 1);
+    }
+};
+
+struct EnchantPwlWithDictSuggs_TestFixture_qaa_lazy : EnchantPwlWithDictSuggs_TestFixture_qaa
+{
+    EnchantPwlWithDictSuggs_TestFixture_qaa_lazy()
+    {
+        enchant_dict_set_lazy_pwl(_dict, 1);
+    }
+};
+
+struct EnchantPwl_TestFixture_qaa_lazy : EnchantPwl_TestFixture_qaa
+{
+    //Setup
+    EnchantPwl_TestFixture_qaa_lazy()
+    {
+        enchant_dict_set_lazy_pwl(_dict, 1);
+    }
+};
+
+struct EnchantPwlProviderSession_TestFixture : EnchantDictionaryTestFixture
+{
+    //Setup
+    EnchantPwlProviderSession_TestFixture():
+        EnchantDictionaryTestFixture(DictionarySession_ProviderConfiguration)
+    {
+        providerSession.clear();
+    }
+};
+
+struct EnchantPwlProviderSession_TestFixture_lazy : EnchantPwlProviderSession_TestFixture
+{
+    //Setup
+    EnchantPwlProviderSession_TestFixture_lazy()
+    {
+        enchant_dict_set_lazy_pwl(_dict, 1);
+    }
+};
+
 #define EnchantPwl_TestFixture EnchantPwl_TestFixture_qaa
 #define EnchantPwlWithDictSuggs_TestFixture EnchantPwlWithDictSuggs_TestFixture_qaa
 #include "pwl.i"
@@ -94,3 +179,186 @@ struct EnchantPwl_TestFixture_qaaqaa : EnchantDictionaryTestFixture
 #undef EnchantPwlWithDictSuggs_TestFixture
 #define EnchantPwlWithDictSuggs_TestFixture EnchantPwlWithDictSuggs_TestFixture_qaaqaa
 #include "pwl.i"
+
+#undef EnchantPwl_TestFixture
+#define EnchantPwl_TestFixture EnchantPwl_TestFixture_qaa_index
+#undef EnchantPwlWithDictSuggs_TestFixture
+#define EnchantPwlWithDictSuggs_TestFixture EnchantPwlWithDictSuggs_TestFixture_qaa_index
+#include "pwl.i"
+
+#undef EnchantPwl_TestFixture
+#define EnchantPwl_TestFixture EnchantPwl_TestFixture_qaa_lazy
+#undef EnchantPwlWithDictSuggs_TestFixture
+#define EnchantPwlWithDictSuggs_TestFixture EnchantPwlWithDictSuggs_TestFixture_qaa_lazy
+#include "pwl.i"
+
+/////////////////////////////////////////////////////////////////////////////
+// Word list index
+TEST_FIXTURE(EnchantPwl_TestFixture_qaa_index,
+             PwlIndex_ListReplacedWithSameSizeAndTime_IndexNotUsed)
+{
+  ExternalAddWordToDictionary("cat");
+  CHECK(IsWordInDictionary("cat"));
+
+  // Replace the list without changing its size or modification time
+  std::string pwl = GetPersonalDictFileName();
+  GStatBuf st;
+  g_stat(pwl.c_str(), &st);
+  g_file_set_contents(pwl.c_str(), "\ndog", -1, NULL);
+  struct utimbuf times;
+  times.actime = st.st_atime;
+  times.modtime = st.st_mtime;
+  g_utime(pwl.c_str(), &times);
+
+  ReloadTestDictionary();
+  enchant_dict_set_pwl_index(_dict, 1);
+
+  CHECK(IsWordInDictionary("dog"));
+  CHECK(!IsWordInDictionary("cat"));
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Passing personal words to the provider
+TEST_FIXTURE(EnchantPwlProviderSession_TestFixture,
+             ProviderSession_WordsPassedWhenRead)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+  ExternalAddWordsToDictionary(sWords);
+
+  CHECK( IsWordInDictionary("cat") );
+  CHECK_EQUAL(2, providerSession.size());
+}
+
+TEST_FIXTURE(EnchantPwlProviderSession_TestFixture_lazy,
+             ProviderSession_Lazy_WordsNotPassedWhenChecked)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+  ExternalAddWordsToDictionary(sWords);
+
+  CHECK( IsWordInDictionary("cat") );
+  CHECK( IsWordInDictionary("hat") );
+  CHECK( IsWordInSession("cat") );
+  CHECK_EQUAL(0, providerSession.size());
+}
+
+TEST_FIXTURE(EnchantPwlProviderSession_TestFixture_lazy,
+             ProviderSession_Lazy_WordsPassedOnceWhenSuggesting)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+  ExternalAddWordsToDictionary(sWords);
+
+  CHECK( IsWordInDictionary("cat") );
+  GetSuggestions("cta");
+  GetSuggestions("hta");
+
+  CHECK_EQUAL(2, providerSession.size());
+  CHECK(std::find(providerSession.begin(), providerSession.end(), "cat") != providerSession.end());
+  CHECK(std::find(providerSession.begin(), providerSession.end(), "hat") != providerSession.end());
+}
+
+TEST_FIXTURE(EnchantPwlProviderSession_TestFixture_lazy,
+             ProviderSession_Lazy_DictionaryRewrittenExternally_OldWordsRemoved)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+  ExternalAddWordsToDictionary(sWords);
+  GetSuggestions("cta");
+
+  sleep(1);
+  FILE * f = g_fopen(GetPersonalDictFileName().c_str(), "w");
+  if(f)
+  {
+      fputs("hat\ndog\n", f);
+      fclose(f);
+  }
+
+  CHECK( !IsWordInDictionary("cat") );
+  GetSuggestions("cta");
+
+  CHECK_EQUAL(2, providerSession.size());
+  CHECK(std::find(providerSession.begin(), providerSession.end(), "hat") != providerSession.end());
+  CHECK(std::find(providerSession.begin(), providerSession.end(), "dog") != providerSession.end());
+}
+
+TEST_FIXTURE(EnchantPwlProviderSession_TestFixture,
+             ProviderSession_LazyEnabledAfterWordsPassed_OldWordsRemoved)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+  ExternalAddWordsToDictionary(sWords);
+  CHECK( IsWordInDictionary("cat") );
+  CHECK_EQUAL(2, providerSession.size());
+
+  enchant_dict_set_lazy_pwl(_dict, 1);
+  sleep(1);
+  FILE * f = g_fopen(GetPersonalDictFileName().c_str(), "w");
+  if(f)
+  {
+      fputs("hat\ndog\n", f);
+      fclose(f);
+  }
+
+  CHECK( !IsWordInDictionary("cat") );
+  GetSuggestions("cta");
+
+  CHECK_EQUAL(2, providerSession.size());
+  CHECK(std::find(providerSession.begin(), providerSession.end(), "hat") != providerSession.end());
+  CHECK(std::find(providerSession.begin(), providerSession.end(), "dog") != providerSession.end());
+}
+
+TEST_FIXTURE(EnchantPwlProviderSession_TestFixture_lazy,
+             ProviderSession_LazyDisabled_WordsPassed)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+  ExternalAddWordsToDictionary(sWords);
+  CHECK( IsWordInDictionary("cat") );
+  CHECK_EQUAL(0, providerSession.size());
+
+  enchant_dict_set_lazy_pwl(_dict, 0);
+
+  CHECK_EQUAL(2, providerSession.size());
+}
+
+TEST_FIXTURE(EnchantPwlProviderSession_TestFixture,
+             ProviderSession_IndexEnabledAfterWordsPassed_WordsRemoved)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+  ExternalAddWordsToDictionary(sWords);
+  CHECK( IsWordInDictionary("cat") );
+  CHECK_EQUAL(2, providerSession.size());
+
+  enchant_dict_set_pwl_index(_dict, 1);
+
+  CHECK_EQUAL(0, providerSession.size());
+  CHECK( IsWordInDictionary("cat") );
+  CHECK_EQUAL(0, providerSession.size());
+}
+
+TEST_FIXTURE(EnchantPwlProviderSession_TestFixture_lazy,
+             ProviderSession_Lazy_IndexEnabledAfterWordsPassed_WordsRemoved)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+  ExternalAddWordsToDictionary(sWords);
+  GetSuggestions("cta");
+  CHECK_EQUAL(2, providerSession.size());
+
+  enchant_dict_set_pwl_index(_dict, 1);
+  GetSuggestions("cta");
+
+  CHECK_EQUAL(0, providerSession.size());
+  CHECK( IsWordInDictionary("cat") );
+}
@@ -60,6 +60,31 @@ TEST_FIXTURE(EnchantPwl_TestFixture,
   }
 }
 
+TEST_FIXTURE(EnchantPwl_TestFixture,
+             IsWordInDictionary_DictionaryRewrittenExternally_OldWordsRemoved)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("hat");
+
+  ExternalAddWordsToDictionary(sWords);
+  CHECK( IsWordInDictionary("cat") );
+
+  // Rewrite the file in place, making it longer, as an editor might.
+  sleep(1);
+  FILE * f = g_fopen(GetPersonalDictFileName().c_str(), "w");
+  if(f)
+  {
+      fputs("hat\ndog\nemu\n", f);
+      fclose(f);
+  }
+
+  CHECK( !IsWordInDictionary("cat") );
+  CHECK( IsWordInDictionary("hat") );
+  CHECK( IsWordInDictionary("dog") );
+  CHECK( IsWordInDictionary("emu") );
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // DictionaryBeginsWithBOM
 TEST_FIXTURE(EnchantPwl_TestFixture, 
@@ -328,6 +353,24 @@ TEST_FIXTURE(EnchantPwl_TestFixture,
 }
 
 
+TEST_FIXTURE(EnchantPwl_TestFixture, 
+             IsWordInDictionary_TitleAndLowerRemoved_AllCapsNotSuccessful)
+{
+  AddWordToDictionary("Eric");
+  AddWordToDictionary("eric");
+
+  RemoveWordFromDictionary("eric");
+
+  CHECK( IsWordInDictionary("ERIC") );
+  CHECK( IsWordInDictionary("Eric") );
+  CHECK(!IsWordInDictionary("eric") );
+
+  RemoveWordFromDictionary("Eric");
+
+  CHECK(!IsWordInDictionary("ERIC") );
+  CHECK(!IsWordInDictionary("Eric") );
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // Remove from PWL
 TEST_FIXTURE(EnchantPwl_TestFixture, 
@@ -655,3 +698,75 @@ TEST_FIXTURE(EnchantPwl_TestFixture,
   }
   CHECK(!IsWordInDictionary(*removed) );
 }
+
+TEST_FIXTURE(EnchantPwl_TestFixture,
+             PwlRemove_ThenAddedAgain_ItemInFile)
+{
+  AddWordToDictionary("cat");
+  AddWordToDictionary("hello");
+  RemoveWordFromDictionary("hello");
+  AddWordToDictionary("hello");
+
+  ReloadTestDictionary(); // to see what actually persisted
+
+  CHECK( IsWordInDictionary("cat") );
+  CHECK( IsWordInDictionary("hello") );
+}
+
+TEST_FIXTURE(EnchantPwl_TestFixture,
+             PwlRemove_CommentLikeTombstone_WordKept)
+{
+  std::vector<std::string> sWords;
+  sWords.push_back("cat");
+  sWords.push_back("#-cat");
+  sWords.push_back("hat");
+  sWords.push_back("bat");
+  ExternalAddWordsToDictionary(sWords);
+
+  CHECK( IsWordInDictionary("cat") );
+
+  RemoveWordFromDictionary("hat");
+
+  ReloadTestDictionary(); // to see what actually persisted
+
+  CHECK( IsWordInDictionary("cat") );
+  CHECK( IsWordInDictionary("bat") );
+  CHECK(!IsWordInDictionary("hat") );
+}
+
+TEST_FIXTURE(EnchantPwl_TestFixture,
+             PwlRemove_AllItemsRemoved_FileCompacted)
+{
+  AddWordToDictionary("cat");
+  AddWordToDictionary("hat");
+  RemoveWordFromDictionary("cat");
+  RemoveWordFromDictionary("hat");
+
+  CHECK(!PersonalWordListFileHasContents());
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Refresh interval
+TEST_FIXTURE(EnchantPwl_TestFixture, 
+             IsWordInDictionary_RefreshInterval_ExternalChangeSeenAfterInterval)
+{
+  CHECK(!IsWordInDictionary("cat"));
+
+  enchant_dict_set_pwl_refresh_interval(_dict, 60 * 60 * 1000);
+  ExternalAddWordToDictionary("cat");
+  CHECK(!IsWordInDictionary("cat"));
+
+  enchant_dict_set_pwl_refresh_interval(_dict, 0);
+  CHECK(IsWordInDictionary("cat"));
+}
+
+TEST_FIXTURE(EnchantPwl_TestFixture, 
+             IsWordInDictionary_RefreshInterval_OwnChangesSeenImmediately)
+{
+  enchant_dict_set_pwl_refresh_interval(_dict, 60 * 60 * 1000);
+  AddWordToDictionary("cat");
+  CHECK(IsWordInDictionary("cat"));
+
+  RemoveWordFromDictionary("cat");
+  CHECK(!IsWordInDictionary("cat"));
+}